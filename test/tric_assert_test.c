@@ -29,24 +29,23 @@ You should have received a copy of the GNU Lesser General Public License along w
 /* macros for reusing code */
 
 #define FAILING_ASSERT_CHECK \
-    assert(lseek(context.self, 0, SEEK_CUR) == line); \
+    assert(context.record->line == line); \
     assert(WEXITSTATUS(status) == EXIT_TEST_FAILURE);
 
 
 
 #define SUCCESSFUL_ASSERT_CHECK \
     line = 0; \
-    assert(lseek(context.self, 0, SEEK_CUR) == line); \
+    assert(context.record->line == line); \
     assert(WEXITSTATUS(status) == EXIT_OK);
 
 
 
 #define ASSERT_TEST(CHECK, NAME, TEST) \
-void NAME(char *argv0) { \
+void NAME(void) { \
     struct tric_suite suite; \
-    struct tric_context context = { .suite = &suite }; \
-    context.self = open(argv0, O_RDONLY); \
-    assert(context.self != -1); \
+    struct tric_context context = { .suite = &suite, .record = tric_map_records(1, -1) }; \
+    assert(context.record != NULL); \
     struct tric_context *tric_context = &context; \
     int status = 0; \
     size_t line = __LINE__; \
@@ -59,7 +58,7 @@ void NAME(char *argv0) { \
         _exit(EXIT_OK); \
     } \
     CHECK; \
-    close(context.self); \
+    tric_unmap_records(context.record, 1); \
 }
 
 
@@ -514,120 +513,120 @@ SUCCESSFUL_ASSERT_TEST(test_assert_float_equal_ok_zero, ASSERT_FLOAT_EQUAL(0.0,
 
 int main(int argc, char *argv[]) {
 
-    test_assert_not_fail(argv[0]);
-    test_assert_not_ok(argv[0]);
-
-    test_assert_equal_fail(argv[0]);
-    test_assert_equal_ok(argv[0]);
-
-    test_assert_not_equal_fail(argv[0]);
-    test_assert_not_equal_ok(argv[0]);
-
-    test_assert_true_fail(argv[0]);
-    test_assert_true_ok(argv[0]);
-
-    test_assert_false_fail(argv[0]);
-    test_assert_false_ok(argv[0]);
-
-    test_assert_null_fail(argv[0]);
-    test_assert_null_ok(argv[0]);
-
-    test_assert_not_null_fail(argv[0]);
-    test_assert_not_null_ok(argv[0]);
-
-    test_assert_zero_fail(argv[0]);
-    test_assert_zero_ok(argv[0]);
-
-    test_assert_not_zero_fail(argv[0]);
-    test_assert_not_zero_ok(argv[0]);
-
-    test_assert_positive_fail(argv[0]);
-    test_assert_positive_zero(argv[0]);
-    test_assert_positive_ok(argv[0]);
-
-    test_assert_negative_fail(argv[0]);
-    test_assert_negative_zero(argv[0]);
-    test_assert_negative_ok(argv[0]);
-
-    test_assert_flag_fail(argv[0]);
-    test_assert_flag_fail_zero(argv[0]);
-    test_assert_flag_ok(argv[0]);
-    test_assert_flag_ok_multiple(argv[0]);
-    test_assert_flag_ok_zero(argv[0]);
-    test_assert_flag_func(argv[0]);
-
-    test_assert_not_flag_fail(argv[0]);
-    test_assert_not_flag_fail_multiple(argv[0]);
-    test_assert_not_flag_ok(argv[0]);
-    test_assert_not_flag_ok_multiple(argv[0]);
-    test_assert_not_flag_ok_zero(argv[0]);
-    test_assert_not_flag_func(argv[0]);
-
-    test_assert_string_equal_null_null(argv[0]);
-    test_assert_string_equal_string_null(argv[0]);
-    test_assert_string_equal_null_string(argv[0]);
-    test_assert_string_equal_fail(argv[0]);
-    test_assert_string_equal_ok(argv[0]);
-    test_assert_string_equal_empty(argv[0]);
-    test_assert_string_equal_func(argv[0]);
-
-    test_assert_string_prefix_null_null(argv[0]);
-    test_assert_string_prefix_string_null(argv[0]);
-    test_assert_string_prefix_null_string(argv[0]);
-    test_assert_string_prefix_fail(argv[0]);
-    test_assert_string_prefix_too_long(argv[0]);
-    test_assert_string_prefix_ok(argv[0]);
-    test_assert_string_prefix_empty_empty(argv[0]);
-    test_assert_string_prefix_empty(argv[0]);
-    test_assert_string_prefix_func(argv[0]);
-
-    test_assert_string_starts_with_ok(argv[0]);
-    test_assert_string_starts_with_fail(argv[0]);
-
-    test_assert_string_suffix_null_null(argv[0]);
-    test_assert_string_suffix_string_null(argv[0]);
-    test_assert_string_suffix_null_string(argv[0]);
-    test_assert_string_suffix_fail(argv[0]);
-    test_assert_string_suffix_too_long(argv[0]);
-    test_assert_string_suffix_ok(argv[0]);
-    test_assert_string_suffix_empty_empty(argv[0]);
-    test_assert_string_suffix_empty(argv[0]);
-    test_assert_string_suffix_func(argv[0]);
-
-    test_assert_string_ends_with_ok(argv[0]);
-    test_assert_string_ends_with_fail(argv[0]);
-
-    test_assert_string_contains_null_null(argv[0]);
-    test_assert_string_contains_string_null(argv[0]);
-    test_assert_string_contains_null_string(argv[0]);
-    test_assert_string_contains_fail(argv[0]);
-    test_assert_string_contains_too_long(argv[0]);
-    test_assert_string_contains_ok(argv[0]);
-    test_assert_string_contains_equal(argv[0]);
-    test_assert_string_contains_empty_empty(argv[0]);
-    test_assert_string_contains_empty(argv[0]);
-    test_assert_string_contains_func(argv[0]);
-
-    test_assert_substring_ok(argv[0]);
-    test_assert_substring_fail(argv[0]);
-
-    test_assert_memory_equal_null_null(argv[0]);
-    test_assert_memory_equal_memory_null(argv[0]);
-    test_assert_memory_equal_null_memory(argv[0]);
-    test_assert_memory_equal_fail(argv[0]);
-    test_assert_memory_equal_ok(argv[0]);
-    test_assert_memory_equal_zero(argv[0]);
-    test_assert_memory_equal_fail_size(argv[0]);
-    test_assert_memory_equal_func(argv[0]);
-
-    test_assert_float_equal_positive_zero(argv[0]);
-    test_assert_float_equal_negative_zero(argv[0]);
-    test_assert_float_equal_positive_negative(argv[0]);
-    test_assert_float_equal_negative_positive(argv[0]);
-    test_assert_float_equal_fail_precision(argv[0]);
-    test_assert_float_equal_ok_positive(argv[0]);
-    test_assert_float_equal_ok_negative(argv[0]);
-    test_assert_float_equal_ok_zero(argv[0]);
+    test_assert_not_fail();
+    test_assert_not_ok();
+
+    test_assert_equal_fail();
+    test_assert_equal_ok();
+
+    test_assert_not_equal_fail();
+    test_assert_not_equal_ok();
+
+    test_assert_true_fail();
+    test_assert_true_ok();
+
+    test_assert_false_fail();
+    test_assert_false_ok();
+
+    test_assert_null_fail();
+    test_assert_null_ok();
+
+    test_assert_not_null_fail();
+    test_assert_not_null_ok();
+
+    test_assert_zero_fail();
+    test_assert_zero_ok();
+
+    test_assert_not_zero_fail();
+    test_assert_not_zero_ok();
+
+    test_assert_positive_fail();
+    test_assert_positive_zero();
+    test_assert_positive_ok();
+
+    test_assert_negative_fail();
+    test_assert_negative_zero();
+    test_assert_negative_ok();
+
+    test_assert_flag_fail();
+    test_assert_flag_fail_zero();
+    test_assert_flag_ok();
+    test_assert_flag_ok_multiple();
+    test_assert_flag_ok_zero();
+    test_assert_flag_func();
+
+    test_assert_not_flag_fail();
+    test_assert_not_flag_fail_multiple();
+    test_assert_not_flag_ok();
+    test_assert_not_flag_ok_multiple();
+    test_assert_not_flag_ok_zero();
+    test_assert_not_flag_func();
+
+    test_assert_string_equal_null_null();
+    test_assert_string_equal_string_null();
+    test_assert_string_equal_null_string();
+    test_assert_string_equal_fail();
+    test_assert_string_equal_ok();
+    test_assert_string_equal_empty();
+    test_assert_string_equal_func();
+
+    test_assert_string_prefix_null_null();
+    test_assert_string_prefix_string_null();
+    test_assert_string_prefix_null_string();
+    test_assert_string_prefix_fail();
+    test_assert_string_prefix_too_long();
+    test_assert_string_prefix_ok();
+    test_assert_string_prefix_empty_empty();
+    test_assert_string_prefix_empty();
+    test_assert_string_prefix_func();
+
+    test_assert_string_starts_with_ok();
+    test_assert_string_starts_with_fail();
+
+    test_assert_string_suffix_null_null();
+    test_assert_string_suffix_string_null();
+    test_assert_string_suffix_null_string();
+    test_assert_string_suffix_fail();
+    test_assert_string_suffix_too_long();
+    test_assert_string_suffix_ok();
+    test_assert_string_suffix_empty_empty();
+    test_assert_string_suffix_empty();
+    test_assert_string_suffix_func();
+
+    test_assert_string_ends_with_ok();
+    test_assert_string_ends_with_fail();
+
+    test_assert_string_contains_null_null();
+    test_assert_string_contains_string_null();
+    test_assert_string_contains_null_string();
+    test_assert_string_contains_fail();
+    test_assert_string_contains_too_long();
+    test_assert_string_contains_ok();
+    test_assert_string_contains_equal();
+    test_assert_string_contains_empty_empty();
+    test_assert_string_contains_empty();
+    test_assert_string_contains_func();
+
+    test_assert_substring_ok();
+    test_assert_substring_fail();
+
+    test_assert_memory_equal_null_null();
+    test_assert_memory_equal_memory_null();
+    test_assert_memory_equal_null_memory();
+    test_assert_memory_equal_fail();
+    test_assert_memory_equal_ok();
+    test_assert_memory_equal_zero();
+    test_assert_memory_equal_fail_size();
+    test_assert_memory_equal_func();
+
+    test_assert_float_equal_positive_zero();
+    test_assert_float_equal_negative_zero();
+    test_assert_float_equal_positive_negative();
+    test_assert_float_equal_negative_positive();
+    test_assert_float_equal_fail_precision();
+    test_assert_float_equal_ok_positive();
+    test_assert_float_equal_ok_negative();
+    test_assert_float_equal_ok_zero();
 
     return 0;
 }
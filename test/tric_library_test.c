@@ -0,0 +1,56 @@
+/*
+TRIC test suite linked against the library
+Copyright 2024 Philip Colombo
+
+This file is part of TRIC.
+
+TRIC is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+TRIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with TRIC.  If not, see <https://www.gnu.org/licenses/>.
+
+*/
+
+
+
+
+/*
+This file is compiled with TRIC_LIBRARY defined and linked against the functions of TRIC built from tric.c.
+The test suite verifies its results in its teardown function, which makes the test suite fail if it is not executed as expected.
+*/
+
+#include "../tric.h"
+#include "../tric_assert.h"
+#include "../tric_output.h"
+
+
+
+bool setup(void *data) {
+    tric_output_environment();
+    return true;
+}
+
+
+
+bool teardown(void *data) {
+    const struct tric_suite *suite = tric_data()->suite;
+    return suite->number_of_tests == 4 && suite->executed_tests == 3 && suite->failed_tests == 0 && suite->skipped_tests == 1;
+}
+
+
+
+SUITE("test suite linked against the library", setup, teardown, NULL) {
+    TEST("assertion", NULL, NULL, NULL) {
+        ASSERT(1 == 1);
+    }
+    TEST("string assertion", NULL, NULL, NULL) {
+        ASSERT_STRING_EQUAL("tric", "tric");
+    }
+    INLINE_TEST("executed in the process of the test suite", NULL, NULL, NULL) {
+        ASSERT_NOT_ZERO(1);
+    }
+    SKIP_TEST("skipped", NULL, NULL, NULL) {
+        ASSERT(0);
+    }
+}
@@ -0,0 +1,50 @@
+/*
+TRIC test suite executed in shards whose results are merged
+Copyright 2024 Philip Colombo
+
+This file is part of TRIC.
+
+TRIC is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+TRIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with TRIC.  If not, see <https://www.gnu.org/licenses/>.
+
+*/
+
+
+
+/*
+The test suite is executed in three shards with the JSON output format. The results of the shards are merged by tric_merge and the merged summary must be the same as the summary of the whole test suite.
+*/
+
+#include "../tric.h"
+#include "../tric_assert.h"
+#include "../tric_output.h"
+
+
+
+bool setup(void *data) {
+    tric_output_environment();
+    return true;
+}
+
+
+
+SUITE("test suite merged from shards", setup, NULL, NULL) {
+    TEST("passing", NULL, NULL, NULL) {
+        ASSERT(1 == 1);
+    }
+    TAGGED_TEST("failing", "merge, shards", NULL, NULL, NULL) {
+        ASSERT(1 == 0);
+    }
+    SKIP_TEST("skipped", NULL, NULL, NULL) {
+        ASSERT(0);
+    }
+    INLINE_TEST("executed in the process of the test suite", NULL, NULL, NULL) {
+        ASSERT_NOT_ZERO(1);
+    }
+    TEST_EACH("case", 3, NULL, NULL, NULL) {
+        ASSERT(TEST_INDEX < 3);
+    }
+}
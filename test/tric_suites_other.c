@@ -0,0 +1,52 @@
+/*
+TRIC test suites linked into one runner
+Copyright 2024 Philip Colombo
+
+This file is part of TRIC.
+
+TRIC is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+TRIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with TRIC.  If not, see <https://www.gnu.org/licenses/>.
+
+*/
+
+
+
+
+/*
+This file is linked together with tric_suites_test.c into one runner.
+*/
+
+#include "../tric.h"
+#include "../tric_assert.h"
+
+
+
+static pid_t suite_process = 0;
+
+
+
+bool setup_fork(void *data) {
+    suite_process = getpid();
+    return true;
+}
+
+
+
+bool teardown_second(void *data) {
+    const struct tric_suite *suite = tric_data()->suite;
+    return suite->number_of_tests == 4 && suite->executed_tests == 4 && suite->failed_tests == 0;
+}
+
+
+
+SUITE("second test suite", setup_fork, teardown_second, NULL) {
+    TEST("executed in a forked process", NULL, NULL, NULL) {
+        ASSERT(getpid() != suite_process);
+    }
+    TEST_EACH("case", 3, NULL, NULL, NULL) {
+        ASSERT_NOT_ZERO(TEST_INDEX + 1);
+    }
+}
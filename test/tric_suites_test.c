@@ -0,0 +1,56 @@
+/*
+TRIC test suites linked into one runner
+Copyright 2024 Philip Colombo
+
+This file is part of TRIC.
+
+TRIC is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+TRIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with TRIC.  If not, see <https://www.gnu.org/licenses/>.
+
+*/
+
+
+
+
+/*
+This file is linked together with tric_suites_other.c into one runner. Both files are compiled with TRIC_MULTIPLE_SUITES defined, this file also contains the runner.
+The test suites verify their results in their teardown functions, which makes the runner fail if a test suite is not executed as expected.
+*/
+
+#define TRIC_RUNNER
+#include "../tric.h"
+#include "../tric_assert.h"
+
+
+
+static pid_t suite_process = 0;
+
+
+
+bool setup_inline(void *data) {
+    /* only affects the tests of this test suite */
+    tric_execute(TRIC_EXECUTE_INLINE);
+    suite_process = getpid();
+    return true;
+}
+
+
+
+bool teardown_first(void *data) {
+    const struct tric_suite *suite = tric_data()->suite;
+    return suite->number_of_tests == 2 && suite->executed_tests == 2 && suite->failed_tests == 0;
+}
+
+
+
+SUITE("first test suite", setup_inline, teardown_first, NULL) {
+    TEST("executed in the process of the runner", NULL, NULL, NULL) {
+        ASSERT(getpid() == suite_process);
+    }
+    TEST("string assertion", NULL, NULL, NULL) {
+        ASSERT_STRING_EQUAL("tric", "tric");
+    }
+}
@@ -23,6 +23,8 @@ You should have received a copy of the GNU Lesser General Public License along w
 /* system under test */
 
 #define TRIC_SELF_TEST
+/* tests created by the test functions must not be found by tric_main */
+#define TRIC_NO_SECTIONS
 #include "../tric.h"
 
 
@@ -118,6 +120,29 @@ void test_log_end_mock(struct tric_suite *suite, struct tric_test *test, void *d
 
 
 
+/* logger mock to record the order of reported tests */
+
+#define TEST_LOG_ORDER_MOCK_SIZE 8
+
+struct test_log_order_mock_data {
+    size_t count;
+    size_t ids[TEST_LOG_ORDER_MOCK_SIZE];
+};
+
+#define TEST_LOG_ORDER_MOCK_DATA_NEW { .count = 0 }
+
+
+
+struct test_log_order_mock_data test_log_order_mock_data = TEST_LOG_ORDER_MOCK_DATA_NEW;
+void test_log_order_mock(struct tric_suite *suite, struct tric_test *test, void *data) {
+    if (test_log_order_mock_data.count < TEST_LOG_ORDER_MOCK_SIZE) {
+        test_log_order_mock_data.ids[test_log_order_mock_data.count] = test->id;
+    }
+    test_log_order_mock_data.count++;
+}
+
+
+
 /* simple test suite function mock */
 
 struct test_suite_mock_data {
@@ -151,6 +176,16 @@ SUITE_DATA("test suite", test_setup_mock, test_teardown_mock, &test_suite_data_r
 
 
 
+/*
+shared memory for the results of tests
+see tric_map_records
+*/
+
+#define TEST_RECORDS_SIZE 3
+struct tric_record *test_records = NULL;
+
+
+
 /* start of tests */
 
 void test_new_suite(void) {
@@ -222,7 +257,7 @@ void test_test_scan(void) {
     /* scanned tests should be contained in linked list of test suite */
 
     struct tric_suite suite = NEW_SUITE(" test suite");
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
     struct tric_context *tric_context = &context;
     pid_t parent = getpid();
 
@@ -254,7 +289,7 @@ void test_test_fail_before(void) {
     /* failing before function should not execute test */
 
     struct tric_suite suite = NEW_SUITE(" test suite");
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
     struct tric_context *tric_context = &context;
     test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
     test_before_mock_data.result = false;
@@ -288,7 +323,7 @@ void test_test_fail_after(void) {
     /* failing after function should not affect test execution */
 
     struct tric_suite suite = NEW_SUITE(" test suite");
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
     struct tric_context *tric_context = &context;
     test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
     test_after_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
@@ -322,7 +357,7 @@ void test_test_ok(void) {
     /* test should be marked as successful */
 
     struct tric_suite suite = NEW_SUITE(" test suite");
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
     struct tric_context *tric_context = &context;
     test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
     test_after_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
@@ -355,7 +390,7 @@ void test_test_no_fixtures(void) {
     /* only test result should be marked as successful */
 
     struct tric_suite suite = NEW_SUITE(" test suite");
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
     struct tric_context *tric_context = &context;
     pid_t parent = getpid();
 
@@ -386,7 +421,7 @@ void test_test_crash(void) {
     /* crashed test should have signal set */
 
     struct tric_suite suite = NEW_SUITE(" test suite");
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
     struct tric_context *tric_context = &context;
     test_after_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
     pid_t parent = getpid();
@@ -421,7 +456,7 @@ void test_test_fail(void) {
     /* failing test should have line set */
 
     struct tric_suite suite = NEW_SUITE(" test suite");
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
     struct tric_context *tric_context = &context;
     test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
     pid_t parent = getpid();
@@ -444,6 +479,8 @@ void test_test_fail(void) {
     assert(context.test->result == TRIC_FAILURE);
     assert(context.test->after == TRIC_UNDEFINED);
     assert(context.test->line != 0);
+    assert(strcmp(context.test->file, __FILE__) == 0);
+    assert(context.test->assertions == 1);
     assert(suite.executed_tests == 1);
     assert(suite.failed_tests == 1);
     assert(suite.skipped_tests == 0);
@@ -455,7 +492,7 @@ void test_skip_test_scan(void) {
     /* scanned skipped tests should be contained in linked list of test suite */
 
     struct tric_suite suite = NEW_SUITE(" test suite");
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
     struct tric_context *tric_context = &context;
     pid_t parent = getpid();
 
@@ -487,7 +524,7 @@ void test_skip_test_ok(void) {
     /* test should be marked as skipped */
 
     struct tric_suite suite = NEW_SUITE(" test suite");
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
     struct tric_context *tric_context = &context;
     test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
     test_after_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
@@ -520,7 +557,7 @@ void test_skip_test_fail_before(void) {
     /* failing before function should not affect skipped test */
 
     struct tric_suite suite = NEW_SUITE(" test suite");
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
     struct tric_context *tric_context = &context;
     test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
     test_before_mock_data.result = false;
@@ -553,7 +590,7 @@ void test_skip_test_fail_after(void) {
     /* failing after function should not affect skipped test */
 
     struct tric_suite suite = NEW_SUITE(" test suite");
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
     struct tric_context *tric_context = &context;
     test_after_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
     test_after_mock_data.result = false;
@@ -586,7 +623,7 @@ void test_skip_test_no_fixtures(void) {
     /* only test result should be marked as skipped */
 
     struct tric_suite suite = NEW_SUITE(" test suite");
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
     struct tric_context *tric_context = &context;
     pid_t parent = getpid();
 
@@ -613,14 +650,13 @@ void test_skip_test_no_fixtures(void) {
 
 
 
-void test_assert_fail(char *argv0) {
+void test_assert_fail(void) {
     /* failing assert should exit subprocess */
 
     struct tric_suite suite;
-    struct tric_context context = { .suite = &suite };
-    context.self = open(argv0, O_RDONLY);
-    assert(context.self != -1);
+    struct tric_context context = { .suite = &suite, .record = test_records };
     struct tric_context *tric_context = &context;
+    tric_reset_record(context.record);
     int status = 0;
 
     size_t line_before = __LINE__;
@@ -633,22 +669,22 @@ void test_assert_fail(char *argv0) {
         _exit(EXIT_OK);
     }
 
-    assert(lseek(context.self, 0, SEEK_CUR) == line_before + 6);
+    assert(context.record->line == line_before + 6);
+    assert(strcmp(context.record->file, __FILE__) == 0);
+    assert(context.record->assertions == 1);
+    assert(context.record->end.tv_sec != 0 || context.record->end.tv_nsec != 0);
     assert(WEXITSTATUS(status) == EXIT_TEST_FAILURE);
-
-    close(context.self);
 }
 
 
 
-void test_assert_pass(char *argv0) {
+void test_assert_pass(void) {
     /* successful assert should not exit subprocess */
 
     struct tric_suite suite;
-    struct tric_context context = { .suite = &suite };
-    context.self = open(argv0, O_RDONLY);
-    assert(context.self != -1);
+    struct tric_context context = { .suite = &suite, .record = test_records };
     struct tric_context *tric_context = &context;
+    tric_reset_record(context.record);
     int status = 0;
 
     pid_t child = fork();
@@ -660,10 +696,10 @@ void test_assert_pass(char *argv0) {
         _exit(EXIT_OK);
     }
 
-    assert(lseek(context.self, 0, SEEK_CUR) == 0);
+    assert(context.record->line == 0);
+    assert(context.record->file == NULL);
+    assert(context.record->assertions == 1);
     assert(WEXITSTATUS(status) == EXIT_OK);
-
-    close(context.self);
 }
 
 
@@ -716,6 +752,34 @@ void test_fixture_reset(void) {
 
 
 
+void test_fixture_parallel(void) {
+    /* fixture should wait for tests running in parallel */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    struct tric_job entries[1];
+    struct tric_queue queue = { .jobs = 2, .capacity = 1, .entries = entries };
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .records = test_records, .number_of_records = TEST_RECORDS_SIZE, .queue = &queue };
+    memset(test_records, 0, TEST_RECORDS_SIZE * sizeof(struct tric_record));
+    struct tric_context *tric_context = &context;
+    tric_log(NULL, NULL, NULL, NULL);
+    size_t running = 1;
+
+    tric_run_test(&context, false, false);
+    if (context.mode == MODE_EXECUTE) {
+        usleep(20000);
+        _exit(EXIT_OK);
+    }
+    FIXTURE("test") {
+        running = queue.running;
+    }
+
+    assert(running == 0);
+    assert(test.result == TRIC_OK);
+}
+
+
+
 void test_add_test_not(void) {
     /* do not add tests when not scanning */
 
@@ -738,7 +802,7 @@ void test_add_test_first(void) {
 
     struct tric_test test = { .id = 0, .next = NULL };
     struct tric_suite suite = { .number_of_tests = 0, .tests = NULL };
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = NULL, .record = test_records };
 
     tric_add_test(&context, &test);
 
@@ -788,22 +852,368 @@ void test_reset_context_not(void) {
 
 
 
-void test_reset_context_run(char *argv0){
+void test_reset_context_run(void){
     /* resetting the context must set mode to execute */
 
-    int self = open(argv0, O_RDONLY);
-    assert(self != -1);
-    assert(lseek(self, 1, SEEK_SET) == 1);
     struct tric_test test;
-    struct tric_context context = { .self = self, .mode = MODE_RESET, .test = NULL };
+    struct tric_context context = { .mode = MODE_RESET, .test = NULL };
 
     tric_reset_context(&context, &test);
 
-    assert(lseek(self, 0, SEEK_CUR) == 0);
     assert(context.test == &test);
     assert(context.mode == MODE_EXECUTE);
+}
+
+
+
+void test_add_each(void) {
+    /* tests of each case should be added to the suite with their index in the description */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_each each = { .description = "case", .options = { .timeout = 2 }, .count = 0, .tests = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+
+    tric_add_each(&context, &each, 12);
+
+    assert(each.count == 12);
+    assert(suite.number_of_tests == 12);
+    assert(suite.tests == &each.tests[0]);
+    assert(each.tests[0].next == &each.tests[1]);
+    assert(each.tests[11].next == NULL);
+    assert(each.tests[11].id == 12);
+    assert(each.tests[11].index == 11);
+    assert(each.tests[11].cases == 12);
+    assert(each.tests[11].options.timeout == 2);
+    assert(strcmp(each.tests[0].description, "case [0]") == 0);
+    assert(strcmp(each.tests[9].description, "case [9]") == 0);
+    assert(strcmp(each.tests[10].description, "case [10]") == 0);
+    assert(strcmp(each.tests[11].description, "case [11]") == 0);
+    free(each.tests);
+}
+
+
+
+void test_add_each_not(void) {
+    /* tests of each case should only be created when scanning for tests */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_each each = { .description = "case", .count = 0, .tests = NULL };
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite };
+
+    tric_add_each(&context, &each, 2);
+    context.mode = MODE_SCAN;
+    tric_add_each(&context, &each, 0);
+
+    assert(each.tests == NULL);
+    assert(suite.number_of_tests == 0);
+}
+
+
+
+void test_next_case(void) {
+    /* context should be prepared for each case one after another */
+
+    struct tric_test tests[] = { NEW_TEST("case [0]"), NEW_TEST("case [1]") };
+    struct tric_each each = { .description = "case", .count = 2, .tests = tests };
+    struct tric_context context = { .mode = MODE_RESET, .test = NULL };
+
+    assert(tric_next_case(&context, &each, 0));
+    assert(context.mode == MODE_EXECUTE);
+    assert(context.test == &tests[0]);
+    assert(tric_next_case(&context, &each, 1) == false);
+
+    context.mode = MODE_RESET;
+    assert(tric_next_case(&context, &each, 1));
+    assert(context.test == &tests[1]);
+
+    context.mode = MODE_RESET;
+    assert(tric_next_case(&context, &each, 2) == false);
+    assert(context.mode == MODE_RESET);
+}
+
+
+
+void test_each_macro(void) {
+    /* tests of each case should be found without executing their code */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    struct tric_context *tric_context = &context;
+    size_t executed = 0;
+
+    TEST_EACH("case", 3, NULL, NULL, NULL) {
+        executed++;
+    }
+
+    assert(suite.number_of_tests == 3);
+    assert(strcmp(suite.tests->next->description, "case [1]") == 0);
+    assert(executed == 0);
+    free(suite.tests);
+}
+
+
+
+void test_each_line(void) {
+    /* tests in the same line should be distinct */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    struct tric_context *tric_context = &context;
+
+    PREPARE_TEST_WITH("1", .execution = TRIC_EXECUTE_DEFAULT) PREPARE_TEST_WITH("2", .execution = TRIC_EXECUTE_DEFAULT)
+
+    assert(suite.number_of_tests == 2);
+    assert(suite.tests != suite.tests->next);
+}
+
+
+
+void test_test_execution_each(void) {
+    /* tests of each case should never be executed inline */
+
+    struct tric_test test = NEW_TEST_WITH("case [0]", .execution = TRIC_EXECUTE_INLINE);
+    struct tric_context context = { .mode = MODE_EXECUTE, .test = &test };
+
+    assert(tric_test_execution(&context) == TRIC_EXECUTE_INLINE);
+    test.cases = 1;
+    assert(tric_test_execution(&context) == TRIC_EXECUTE_FORK);
+    test.options.execution = TRIC_EXECUTE_SPAWN;
+    assert(tric_test_execution(&context) == TRIC_EXECUTE_SPAWN);
+}
+
+
+
+void test_register_tests_each(void) {
+    /* suite should be scanned if tests are created for each case */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("1");
+    struct tric_entry entries[] = { { .test = &test, .order = 1 }, { .test = NULL, .order = 2 } };
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite };
+
+    assert(tric_register_tests(&context, entries, entries + 2) == false);
+    assert(suite.number_of_tests == 0);
+}
+
+
+
+void test_fixture_spawn(void) {
+    /* code in fixture should only execute in spawned processes if all tests are spawned */
+
+    struct tric_suite test_suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    test_suite.tests = &test;
+    struct tric_context context = { .mode = MODE_RESET, .suite = &test_suite, .records_file = 3 };
+    struct tric_context *tric_context = &context;
+    bool suite = false;
+    bool spawned = false;
+    tric_settings()->execution = TRIC_EXECUTE_SPAWN;
+
+    FIXTURE("test") {
+        suite = true;
+    }
+    context.spawned = 1;
+    FIXTURE("test") {
+        spawned = true;
+    }
+
+    tric_settings()->execution = TRIC_EXECUTE_FORK;
+    assert(suite == false);
+    assert(spawned == true);
+}
+
+
+
+void test_fixture_spawn_override(void) {
+    /* code in fixture should also execute in the process of the test suite if a test is not spawned */
+
+    struct tric_suite test_suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("spawned"), NEW_TEST_WITH("forked", .execution = TRIC_EXECUTE_FORK), NEW_TEST_WITH("inline", .execution = TRIC_EXECUTE_INLINE) };
+    test_suite.tests = &tests[0];
+    tests[0].next = &tests[1];
+    struct tric_context context = { .mode = MODE_RESET, .suite = &test_suite, .records_file = 3 };
+    struct tric_context *tric_context = &context;
+    size_t count = 0;
+    tric_settings()->execution = TRIC_EXECUTE_SPAWN;
+
+    FIXTURE("test") {
+        count++;
+    }
+    tests[0].next = &tests[2];
+    FIXTURE("test") {
+        count++;
+    }
+    tests[0].next = NULL;
+    FIXTURE("test") {
+        count++;
+    }
+
+    tric_settings()->execution = TRIC_EXECUTE_FORK;
+    assert(count == 2);
+}
 
-    close(self);
+
+
+void test_create_records_file(void) {
+    /* records mapped from the file should be shared */
+
+#ifdef SYS_memfd_create
+    int file = tric_create_records_file(2);
+    assert(file >= 0);
+    struct tric_record *records = tric_map_records(2, file);
+    struct tric_record *mapping = tric_map_records(2, file);
+    assert(records != NULL);
+    assert(mapping != NULL);
+
+    records[1].line = 1;
+
+    assert(mapping[1].line == 1);
+    tric_unmap_records(records, 2);
+    tric_unmap_records(mapping, 2);
+    close(file);
+#else
+    assert(tric_create_records_file(2) == -1);
+#endif
+}
+
+
+
+void test_map_records(void) {
+    /* results should be shared with child processes */
+
+    struct tric_record *records = tric_map_records(2, -1);
+    assert(records != NULL);
+    assert(records[1].used == false);
+
+    pid_t child = fork();
+    assert(child != -1);
+    if (child == 0) {
+        records[1].line = 1;
+        _exit(EXIT_OK);
+    }
+    waitpid(child, NULL, 0);
+
+    assert(records[1].line == 1);
+
+    tric_unmap_records(records, 2);
+}
+
+
+
+void test_unused_record(void) {
+    /* first record not used by a running test should be found */
+
+    struct tric_record records[] = { { .used = true }, { .used = false } };
+    struct tric_context context = { .records = records, .number_of_records = 2 };
+
+    assert(tric_unused_record(&context) == &records[1]);
+
+    records[1].used = true;
+
+    assert(tric_unused_record(&context) == NULL);
+}
+
+
+
+void test_reset_record(void) {
+    /* record should be cleared and marked as used */
+
+    struct tric_record record = { .used = false, .line = 1, .file = "file", .assertions = 1, .end = { .tv_sec = 1 } };
+
+    tric_reset_record(&record);
+
+    assert(record.used == true);
+    assert(record.line == 0);
+    assert(record.file == NULL);
+    assert(record.assertions == 0);
+    assert(record.end.tv_sec == 0);
+}
+
+
+
+void test_read_record(void) {
+    /* number of assertions and duration should be copied */
+
+    struct tric_record record = { .assertions = 3, .start = { .tv_sec = 1, .tv_nsec = 500000000 }, .end = { .tv_sec = 3 } };
+    struct tric_test test = NEW_TEST("test");
+    struct tric_context context = { .test = &test, .record = &record };
+
+    tric_read_record(&context);
+
+    assert(test.assertions == 3);
+    assert(test.duration == 1.5);
+}
+
+
+
+void test_read_record_crash(void) {
+    /* duration should be measured until now if the test did not finish */
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    struct tric_record record = { .assertions = 3, .start = start };
+    struct tric_test test = NEW_TEST("test");
+    struct tric_context context = { .test = &test, .record = &record };
+
+    tric_read_record(&context);
+
+    assert(test.assertions == 3);
+    assert(test.duration >= 0);
+    assert(test.duration < 1);
+    assert(record.end.tv_sec != 0 || record.end.tv_nsec != 0);
+}
+
+
+
+void test_read_record_backtrace(void) {
+    /* backtrace of crashed test should be copied */
+
+    int first, second;
+    struct tric_record record = { .frames = 2, .backtrace = { &first, &second } };
+    struct tric_test test = NEW_TEST("test");
+    struct tric_context context = { .test = &test, .record = &record };
+
+    tric_read_record(&context);
+
+    assert(test.frames == 2);
+    assert(test.backtrace[0] == &first);
+    assert(test.backtrace[1] == &second);
+}
+
+
+
+void test_read_record_spawned(void) {
+    /* pointers written by a spawned process should be moved to the address space of the test suite */
+
+    const char *origin = (const char *)tric_data()->suite;
+    struct tric_record record = { .file = origin + 100 + 16, .origin = origin + 100, .frames = 1 };
+    struct tric_test test = NEW_TEST("test");
+    struct tric_context context = { .test = &test, .record = &record };
+
+    tric_read_record(&context);
+
+    assert(record.file == origin + 16);
+    assert(test.frames == 0);
+}
+
+
+
+void test_read_usage(void) {
+    /* resource usage since the start of the test should be copied */
+
+    struct rusage start = { .ru_utime = { .tv_sec = 1, .tv_usec = 500000 }, .ru_stime = { .tv_sec = 1 }, .ru_maxrss = 100, .ru_minflt = 10, .ru_majflt = 1, .ru_nvcsw = 5, .ru_nivcsw = 2 };
+    struct rusage end = { .ru_utime = { .tv_sec = 2 }, .ru_stime = { .tv_sec = 1, .tv_usec = 250000 }, .ru_maxrss = 200, .ru_minflt = 15, .ru_majflt = 3, .ru_nvcsw = 6, .ru_nivcsw = 6 };
+    struct tric_test test = NEW_TEST("test");
+
+    tric_read_usage(&test, &start, &end);
+
+    assert(test.user_time == 0.5);
+    assert(test.system_time == 0.25);
+    assert(test.max_rss == 200);
+    assert(test.minor_faults == 5);
+    assert(test.major_faults == 2);
+    assert(test.voluntary_switches == 1);
+    assert(test.involuntary_switches == 4);
 }
 
 
@@ -868,21 +1278,19 @@ void test_status_ok_after(void) {
 
 
 
-void test_status_fail_all(char *argv0) {
+void test_status_fail_all(void) {
     /* all result states should be set */
 
-    int self = open(argv0, O_RDONLY);
-    assert(self != -1);
-    assert(lseek(self, 1, SEEK_SET) == 1);
+    struct tric_record record = { .line = 1, .file = "file" };
     struct tric_suite suite = { .failed_tests = 0 };
     struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED, .line = 0 };
-    struct tric_context context = { .self = self, .suite = &suite, .test = &test };
+    struct tric_context context = { .record = &record, .suite = &suite, .test = &test };
 
     tric_status_fail(&context, true, true);
-    close(self);
 
     assert(suite.failed_tests == 1);
     assert(test.line == 1);
+    assert(strcmp(test.file, "file") == 0);
     assert(test.before == TRIC_OK);
     assert(test.result == TRIC_FAILURE);
     assert(test.after == TRIC_SKIPPED);
@@ -890,17 +1298,15 @@ void test_status_fail_all(char *argv0) {
 
 
 
-void test_status_fail_none(char *argv0) {
+void test_status_fail_none(void) {
     /* only test result state should be set */
 
-    int self = open(argv0, O_RDONLY);
-    assert(self != -1);
+    struct tric_record record = { .line = 1, .file = "file" };
     struct tric_suite suite = { .failed_tests = 0 };
     struct tric_test test = { .before = TRIC_OK, .result = TRIC_UNDEFINED, .after = TRIC_OK, .line = 0 };
-    struct tric_context context = { .self = self, .suite = &suite, .test = &test };
+    struct tric_context context = { .record = &record, .suite = &suite, .test = &test };
 
     tric_status_fail(&context, false, false);
-    close(self);
 
     assert(test.before == TRIC_UNDEFINED);
     assert(test.result == TRIC_FAILURE);
@@ -909,17 +1315,15 @@ void test_status_fail_none(char *argv0) {
 
 
 
-void test_status_fail_before(char *argv0) {
+void test_status_fail_before(void) {
     /* before result state should be set */
 
-    int self = open(argv0, O_RDONLY);
-    assert(self != -1);
+    struct tric_record record = { .line = 1, .file = "file" };
     struct tric_suite suite = { .failed_tests = 0 };
     struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_OK, .line = 0 };
-    struct tric_context context = { .self = self, .suite = &suite, .test = &test };
+    struct tric_context context = { .record = &record, .suite = &suite, .test = &test };
 
     tric_status_fail(&context, true, false);
-    close(self);
 
     assert(test.before == TRIC_OK);
     assert(test.result == TRIC_FAILURE);
@@ -928,17 +1332,15 @@ void test_status_fail_before(char *argv0) {
 
 
 
-void test_status_fail_after(char *argv0) {
+void test_status_fail_after(void) {
     /* after result state should be set */
 
-    int self = open(argv0, O_RDONLY);
-    assert(self != -1);
+    struct tric_record record = { .line = 1, .file = "file" };
     struct tric_suite suite = { .failed_tests = 0 };
     struct tric_test test = { .before = TRIC_OK, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED, .line = 0 };
-    struct tric_context context = { .self = self, .suite = &suite, .test = &test };
+    struct tric_context context = { .record = &record, .suite = &suite, .test = &test };
 
     tric_status_fail(&context, false, true);
-    close(self);
 
     assert(test.before == TRIC_UNDEFINED);
     assert(test.result == TRIC_FAILURE);
@@ -1296,17 +1698,15 @@ void test_set_status_ok(void) {
 
 
 
-void test_set_status_test_failure(char *argv0) {
+void test_set_status_test_failure(void) {
     /* fail test status should be called */
 
-    int self = open(argv0, O_RDONLY);
-    assert(self != -1);
+    struct tric_record record = { .line = 1, .file = "file" };
     struct tric_suite suite = { .failed_tests = 0 };
     struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED, .line = 0 };
-    struct tric_context context = { .self = self, .suite = &suite, .test = &test };
+    struct tric_context context = { .record = &record, .suite = &suite, .test = &test };
 
     tric_set_status(&context, EXIT_TEST_FAILURE, true, true);
-    close(self);
 
     assert(suite.failed_tests == 1);
     assert(test.before == TRIC_OK);
@@ -1365,75 +1765,162 @@ void test_set_status_signal(void) {
 
 
 
-void test_set_status_fork(void) {
-    /* fail fork status should be called */
+void test_status_timeout(void) {
+    /* all result states should be set */
 
-    struct tric_test test = { .before = TRIC_OK, .result = TRIC_OK, .after = TRIC_OK };
-    struct tric_suite suite = { .skipped_tests = 0 };
+    struct tric_suite suite = { .failed_tests = 0 };
+    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED };
     struct tric_context context = { .suite = &suite, .test = &test };
 
-    tric_set_status(&context, EXIT_FORK, true, true);
+    tric_status_timeout(&context, false, true);
 
-    assert(suite.skipped_tests == 1);
+    assert(suite.failed_tests == 1);
     assert(test.before == TRIC_UNDEFINED);
-    assert(test.result == TRIC_UNDEFINED);
-    assert(test.after == TRIC_UNDEFINED);
+    assert(test.result == TRIC_TIMEOUT);
+    assert(test.after == TRIC_TIMEOUT);
 }
 
 
 
-void test_set_status_skip(void) {
-    /* skip status should be called */
+void test_set_status_timeout(void) {
+    /* timeout status should be called */
 
+    struct tric_suite suite = { .failed_tests = 0 };
     struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED };
-    struct tric_suite suite = { .skipped_tests = 0 };
     struct tric_context context = { .suite = &suite, .test = &test };
 
-    tric_set_status(&context, EXIT_SKIP, true, true);
+    tric_set_status(&context, EXIT_TIMEOUT, true, true);
 
-    assert(suite.skipped_tests == 1);
-    assert(test.before == TRIC_SKIPPED);
-    assert(test.result == TRIC_SKIPPED);
-    assert(test.after == TRIC_SKIPPED);
+    assert(suite.failed_tests == 1);
+    assert(test.before == TRIC_TIMEOUT);
+    assert(test.result == TRIC_TIMEOUT);
+    assert(test.after == TRIC_TIMEOUT);
 }
 
 
 
-void test_run_test_not(void) {
-    /* test should not run when scanning for tests */
+void test_status_exceeded(void) {
+    /* all result states should be set */
 
-    struct tric_context context = { .mode = MODE_SCAN };
+    struct tric_suite suite = { .failed_tests = 0 };
+    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED };
+    struct tric_context context = { .suite = &suite, .test = &test };
 
-    tric_run_test(&context, true, true);
+    tric_status_exceeded(&context, true, false);
 
-    assert(context.mode == MODE_SCAN);
+    assert(suite.failed_tests == 1);
+    assert(test.before == TRIC_EXCEEDED);
+    assert(test.result == TRIC_EXCEEDED);
+    assert(test.after == TRIC_UNDEFINED);
 }
 
 
 
-void test_run_test_ok(void) {
-    /* test should run successfully */
+void test_set_status_exceeded(void) {
+    /* exceeded status should be called */
 
-    struct tric_suite suite = { .executed_tests = 0 };
-    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_OK };
-    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test };
-    tric_log(NULL, test_log_test_mock, NULL, &context);
-    test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
-    pid_t parent = getpid();
+    struct tric_suite suite = { .failed_tests = 0 };
+    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED };
+    struct tric_context context = { .suite = &suite, .test = &test };
 
-    tric_run_test(&context, true, false);
-    if (context.mode == MODE_EXECUTE) {
-        assert(getpid() != parent);
-        _exit(EXIT_OK);
-    }
+    tric_set_status(&context, EXIT_EXCEEDED, true, true);
 
-    assert(context.mode == MODE_RESET);
-    assert(suite.executed_tests == 1);
-    assert(test.before == TRIC_OK);
-    assert(test.result == TRIC_OK);
-    assert(test.after == TRIC_UNDEFINED);
-    assert(test_log_test_mock_data.count == 1);
-    assert(test_log_test_mock_data.suite == &suite);
+    assert(suite.failed_tests == 1);
+    assert(test.before == TRIC_EXCEEDED);
+    assert(test.result == TRIC_EXCEEDED);
+    assert(test.after == TRIC_EXCEEDED);
+}
+
+
+
+void test_set_status_fork(void) {
+    /* fail fork status should be called */
+
+    struct tric_test test = { .before = TRIC_OK, .result = TRIC_OK, .after = TRIC_OK };
+    struct tric_suite suite = { .skipped_tests = 0 };
+    struct tric_context context = { .suite = &suite, .test = &test };
+
+    tric_set_status(&context, EXIT_FORK, true, true);
+
+    assert(suite.skipped_tests == 1);
+    assert(test.before == TRIC_UNDEFINED);
+    assert(test.result == TRIC_UNDEFINED);
+    assert(test.after == TRIC_UNDEFINED);
+}
+
+
+
+void test_set_status_not_started(void) {
+    /* test whose process could not start it should not be counted as executed */
+
+    struct tric_test test = { .before = TRIC_OK, .result = TRIC_OK, .after = TRIC_OK };
+    struct tric_suite suite = { .executed_tests = 1, .skipped_tests = 0 };
+    struct tric_context context = { .suite = &suite, .test = &test };
+
+    tric_set_status(&context, EXIT_NOT_STARTED, true, true);
+
+    assert(suite.executed_tests == 0);
+    assert(suite.skipped_tests == 1);
+    assert(test.before == TRIC_UNDEFINED);
+    assert(test.result == TRIC_UNDEFINED);
+    assert(test.after == TRIC_UNDEFINED);
+}
+
+
+
+void test_set_status_skip(void) {
+    /* skip status should be called */
+
+    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED };
+    struct tric_suite suite = { .skipped_tests = 0 };
+    struct tric_context context = { .suite = &suite, .test = &test };
+
+    tric_set_status(&context, EXIT_SKIP, true, true);
+
+    assert(suite.skipped_tests == 1);
+    assert(test.before == TRIC_SKIPPED);
+    assert(test.result == TRIC_SKIPPED);
+    assert(test.after == TRIC_SKIPPED);
+}
+
+
+
+void test_run_test_not(void) {
+    /* test should not run when scanning for tests */
+
+    struct tric_context context = { .mode = MODE_SCAN };
+
+    tric_run_test(&context, true, true);
+
+    assert(context.mode == MODE_SCAN);
+}
+
+
+
+void test_run_test_ok(void) {
+    /* test should run successfully */
+
+    struct tric_suite suite = { .executed_tests = 0 };
+    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_OK };
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
+    pid_t parent = getpid();
+
+    tric_run_test(&context, true, false);
+    if (context.mode == MODE_EXECUTE) {
+        assert(getpid() != parent);
+        _exit(EXIT_OK);
+    }
+
+    assert(context.mode == MODE_RESET);
+    assert(suite.executed_tests == 1);
+    assert(test.before == TRIC_OK);
+    assert(test.result == TRIC_OK);
+    assert(test.after == TRIC_UNDEFINED);
+    assert(test.max_rss > 0);
+    assert(test_log_test_mock_data.count == 1);
+    assert(test_log_test_mock_data.suite == &suite);
     assert(test_log_test_mock_data.test == &test);
     assert(test_log_test_mock_data.data == &context);
 }
@@ -1445,7 +1932,7 @@ void test_run_test_signal(void) {
 
     struct tric_suite suite = { .executed_tests = 0, .failed_tests = 0 };
     struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED, .signal = 0 };
-    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test };
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
     tric_log(NULL, test_log_test_mock, NULL, &context);
     test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
     pid_t parent = getpid();
@@ -1473,320 +1960,2541 @@ void test_run_test_signal(void) {
 
 
 
-void test_run_before_not(void) {
-    /* before function should not run */
+void test_run_test_timeout(void) {
+    /* hanging test should be terminated after its timeout */
 
-    struct tric_context context = { .mode = MODE_SCAN };
-    test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST_WITH("test", .timeout = 0.05);
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
+    pid_t parent = getpid();
 
-    tric_run_before(&context, test_before_mock, &context);
+    tric_run_test(&context, false, false);
+    if (context.mode == MODE_EXECUTE) {
+        assert(getpid() != parent);
+        assert(getpgid(0) == getpid());
+        pause();
+        _exit(EXIT_OK);
+    }
 
-    assert(test_before_mock_data.count == 0);
-    assert(test_before_mock_data.data == NULL);
+    assert(context.mode == MODE_RESET);
+    assert(suite.executed_tests == 1);
+    assert(suite.failed_tests == 1);
+    assert(test.result == TRIC_TIMEOUT);
+    assert(test.duration >= 0.05);
+    assert(test_log_test_mock_data.count == 1);
 }
 
 
 
-void test_run_before_null(void) {
-    /* nothing should run */
+void test_run_test_stragglers(void) {
+    /* processes left by the test should be killed and counted */
 
-    struct tric_context context = { .mode = MODE_EXECUTE };
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    pid_t parent = getpid();
+#ifdef __linux__
+    prctl(PR_SET_CHILD_SUBREAPER, 1);
+#endif
+
+    tric_run_test(&context, false, false);
+    if (context.mode == MODE_EXECUTE) {
+        assert(getpid() != parent);
+        if (fork() == 0) {
+            if (fork() == 0) {
+                pause();
+            }
+            pause();
+        }
+        _exit(EXIT_OK);
+    }
+
+    assert(context.mode == MODE_RESET);
+    assert(test.result == TRIC_OK);
+    assert(test.stragglers == 2);
+}
+
+
+
+void test_reap_group(void) {
+    /* empty process group should have no stragglers */
 
-    int status;
     pid_t child = fork();
     assert(child != -1);
-    if (child) {
-        waitpid(child, &status, 0);
-    } else {
-        tric_run_before(&context, NULL, NULL);
+    if (child == 0) {
+        setpgid(0, 0);
+        _exit(EXIT_OK);
+    }
+    setpgid(child, child);
+    waitpid(child, NULL, 0);
+
+    assert(tric_reap_group(child) == 0);
+}
+
+
+
+void test_has_children(void) {
+    /* processes that were not waited for should be found */
+
+    assert(tric_has_children() == false);
+    pid_t child = fork();
+    assert(child != -1);
+    if (child == 0) {
+        _exit(EXIT_OK);
+    }
+
+    assert(tric_has_children());
+    waitpid(child, NULL, 0);
+    assert(tric_has_children() == false);
+}
+
+
+
+void test_run_test_limits(void) {
+    /* resource limits should be applied and violations should be marked */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST_WITH("test", .cpu_limit = 10, .file_limit = 8);
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    pid_t parent = getpid();
+
+    tric_run_test(&context, false, false);
+    if (context.mode == MODE_EXECUTE) {
+        assert(getpid() != parent);
+        struct rlimit limit;
+        getrlimit(RLIMIT_NOFILE, &limit);
+        assert(limit.rlim_cur == 8);
+        getrlimit(RLIMIT_CPU, &limit);
+        assert(limit.rlim_cur == 10);
+        raise(SIGXCPU);
+        _exit(EXIT_OK);
+    }
+
+    assert(context.mode == MODE_RESET);
+    assert(suite.failed_tests == 1);
+    assert(test.result == TRIC_EXCEEDED);
+    assert(test.signal == SIGXCPU);
+}
+
+
+
+void test_run_test_core_dump(void) {
+    /* core dumps should only be written if allowed for the test */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    struct tric_test core_test = NEW_TEST_WITH("test", .core_dump = true);
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    struct rlimit inherited;
+    getrlimit(RLIMIT_CORE, &inherited);
+
+    tric_run_test(&context, false, false);
+    if (context.mode == MODE_EXECUTE) {
+        struct rlimit limit;
+        getrlimit(RLIMIT_CORE, &limit);
+        _exit(limit.rlim_cur == 0 ? EXIT_OK : EXIT_TEST_FAILURE);
+    }
+
+    assert(test.result == TRIC_OK);
+
+    context.mode = MODE_EXECUTE;
+    context.test = &core_test;
+    tric_run_test(&context, false, false);
+    if (context.mode == MODE_EXECUTE) {
+        struct rlimit limit;
+        getrlimit(RLIMIT_CORE, &limit);
+        _exit(limit.rlim_cur == inherited.rlim_cur ? EXIT_OK : EXIT_TEST_FAILURE);
+    }
+
+    assert(core_test.result == TRIC_OK);
+    assert(suite.failed_tests == 0);
+}
+
+
+
+void test_run_test_crash_backtrace(void) {
+    /* backtrace of crashing test should be recorded */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    tric_settings()->backtrace = true;
+
+    tric_run_test(&context, false, false);
+    if (context.mode == MODE_EXECUTE) {
+        raise(SIGSEGV);
+        _exit(EXIT_OK);
+    }
+
+    tric_settings()->backtrace = false;
+    assert(test.result == TRIC_CRASHED);
+    assert(test.signal == SIGSEGV);
+#ifdef __GLIBC__
+    assert(test.frames > 0);
+#else
+    assert(test.frames == 0);
+#endif
+}
+
+
+
+void test_run_test_spawned(void) {
+    /* only the test with the ID of the spawned process should be executed in the process itself */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test other_test = NEW_TEST("other test");
+    struct tric_test test = NEW_TEST("test");
+    other_test.id = 1;
+    test.id = 2;
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &other_test, .record = test_records, .spawned = 2 };
+    tric_reset_record(test_records);
+
+    tric_run_test(&context, false, false);
+
+    assert(context.mode == MODE_RESET);
+    assert(test_records[0].origin == NULL);
+
+    pid_t child = fork();
+    assert(child != -1);
+    if (child == 0) {
+        context.mode = MODE_EXECUTE;
+        context.test = &test;
+        tric_run_test(&context, false, false);
+        _exit(context.mode == MODE_EXECUTE && getpid() == getpgid(0) ? EXIT_OK : EXIT_TEST_FAILURE);
+    }
+    int status;
+    waitpid(child, &status, 0);
+
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_OK);
+    assert(test_records[0].origin == (const char *)tric_data()->suite);
+    assert(suite.executed_tests == 0);
+}
+
+
+
+void test_run_test_retries(void) {
+    /* failing run should be executed again */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST_WITH("test", .retries = 2);
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+
+    tric_run_test(&context, false, false);
+    if (context.mode == MODE_EXECUTE) {
+        _exit(context.record->runs < 2 ? EXIT_TEST_FAILURE : EXIT_OK);
+    }
+
+    assert(suite.failed_tests == 0);
+    assert(test.result == TRIC_OK);
+    assert(test.runs == 2);
+    assert(test.failed_runs == 1);
+}
+
+
+
+void test_run_test_repeat(void) {
+    /* test should be executed until it failed or passed the number of runs */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST_WITH("test", .repeat = 3);
+    struct tric_test failing_test = NEW_TEST_WITH("test", .repeat = 3);
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    pid_t parent = getpid();
+
+    tric_run_test(&context, false, false);
+    if (context.mode == MODE_EXECUTE) {
+        /* each run is executed in a new process */
+        assert(getppid() != parent);
+        _exit(EXIT_OK);
+    }
+
+    assert(test.result == TRIC_OK);
+    assert(test.runs == 3);
+    assert(test.failed_runs == 0);
+
+    context.mode = MODE_EXECUTE;
+    context.test = &failing_test;
+    tric_run_test(&context, false, false);
+    if (context.mode == MODE_EXECUTE) {
+        if (context.record->runs == 2) {
+            raise(SIGSEGV);
+        }
         _exit(EXIT_OK);
     }
 
-    assert(WEXITSTATUS(status) == EXIT_OK);
+    assert(suite.failed_tests == 1);
+    assert(failing_test.result == TRIC_CRASHED);
+    assert(failing_test.signal == SIGSEGV);
+    assert(failing_test.runs == 2);
+    assert(failing_test.failed_runs == 1);
+}
+
+
+
+void test_run_test_shared_before(void) {
+    /* test should be forked after the shared before function was executed */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST_WITH("test", .share_before = true);
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records, .records = test_records, .number_of_records = TEST_RECORDS_SIZE };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+
+    tric_run_test(&context, true, false);
+    if (context.mode == MODE_EXECUTE) {
+        pid_t group = getpid();
+        tric_run_before(&context, test_before_mock, &test);
+        if (context.mode == MODE_EXECUTE) {
+            /* the before function is not executed again in the process of the test */
+            _exit(getppid() == group && test_before_mock_data.count == 1 ? EXIT_TEST_FAILURE : EXIT_OK);
+        }
+        tric_end_batch(&context);
+    }
+
+    assert(context.mode == MODE_RESET);
+    assert(test_before_mock_data.count == 0);
+    assert(suite.executed_tests == 1);
+    assert(suite.failed_tests == 1);
+    assert(test.before == TRIC_OK);
+    assert(test.result == TRIC_FAILURE);
+    assert(context.batch.pending == 0);
+}
+
+
+
+void test_run_test_inline_after_shared_before(void) {
+    /* test executed in the process of the test suite after a group should execute its own before function */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test shared_test = NEW_TEST_WITH("test", .share_before = true);
+    struct tric_test inline_test = NEW_TEST_WITH("test", .execution = TRIC_EXECUTE_INLINE);
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &shared_test, .record = test_records, .records = test_records, .number_of_records = TEST_RECORDS_SIZE };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+    pid_t parent = getpid();
+
+    tric_run_test(&context, true, false);
+    if (context.mode == MODE_EXECUTE) {
+        tric_run_before(&context, test_before_mock, NULL);
+        if (context.mode == MODE_EXECUTE) {
+            _exit(EXIT_OK);
+        }
+        tric_end_batch(&context);
+    }
+    context.mode = MODE_EXECUTE;
+    context.test = &inline_test;
+    assert(tric_run_test(&context, true, false));
+    assert(context.batch.shared == false);
+    tric_run_before(&context, test_before_mock, NULL);
+    assert(getpid() == parent);
+    assert(context.mode == MODE_EXECUTE);
+    tric_run_after(&context, NULL, NULL);
+
+    assert(test_before_mock_data.count == 1);
+    assert(shared_test.result == TRIC_OK);
+    assert(inline_test.before == TRIC_OK);
+    assert(inline_test.result == TRIC_OK);
+    assert(suite.executed_tests == 2);
+}
+
+
+
+void test_run_before_shared_other(void) {
+    /* test with another before function should end the group */
+
+    struct tric_test test = NEW_TEST_WITH("test", .share_before = true);
+    struct tric_context context = { .mode = MODE_EXECUTE, .test = &test, .record = test_records, .batch = { .child = true, .shared = true, .before = test_after_mock } };
+    tric_reset_record(test_records);
+
+    pid_t child = fork();
+    assert(child != -1);
+    if (child == 0) {
+        tric_run_before(&context, test_before_mock, NULL);
+        _exit(EXIT_TEST_FAILURE);
+    }
+    int status;
+    waitpid(child, &status, 0);
+
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_OK);
+    assert(test_records[0].used == false);
+    assert(test_records[0].finished == false);
+}
+
+
+
+void test_run_test_parallel(void) {
+    /* tests should run in parallel and should be reported in order */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3") };
+    tests[0].id = 1;
+    tests[1].id = 2;
+    tests[2].id = 3;
+    struct tric_job entries[3];
+    struct tric_queue queue = { .jobs = 2, .capacity = 3, .entries = entries };
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite, .records = test_records, .number_of_records = TEST_RECORDS_SIZE, .queue = &queue };
+    memset(test_records, 0, TEST_RECORDS_SIZE * sizeof(struct tric_record));
+    tric_log(NULL, test_log_order_mock, NULL, NULL);
+    test_log_order_mock_data = (struct test_log_order_mock_data)TEST_LOG_ORDER_MOCK_DATA_NEW;
+    pid_t parent = getpid();
+
+    size_t i;
+    for (i = 0; i < 3; i++) {
+        context.mode = MODE_EXECUTE;
+        context.test = &tests[i];
+        tric_run_test(&context, false, true);
+        if (context.mode == MODE_EXECUTE) {
+            assert(getpid() != parent);
+            usleep((3 - i) * 20000);
+            _exit(i == 1 ? EXIT_AFTER_FAILURE : EXIT_OK);
+        }
+        assert(queue.running <= 2);
+    }
+    tric_finish_jobs(&context);
+
+    assert(queue.running == 0);
+    assert(queue.length == 0);
+    assert(suite.executed_tests == 3);
+    assert(suite.failed_tests == 0);
+    assert(tests[0].result == TRIC_OK);
+    assert(tests[1].after == TRIC_FAILURE);
+    assert(tests[2].after == TRIC_OK);
+    assert(test_log_order_mock_data.count == 3);
+    assert(test_log_order_mock_data.ids[0] == 1);
+    assert(test_log_order_mock_data.ids[1] == 2);
+    assert(test_log_order_mock_data.ids[2] == 3);
+}
+
+
+
+void test_run_test_inline(void) {
+    /* test should run in the process of the test suite */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST_WITH("test", .execution = TRIC_EXECUTE_INLINE);
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
+    pid_t parent = getpid();
+
+    assert(tric_run_test(&context, false, true));
+    assert(getpid() == parent);
+    assert(context.mode == MODE_EXECUTE);
+    assert(context.record != test_records);
+    tric_run_after(&context, NULL, NULL);
+
+    assert(context.mode == MODE_RESET);
+    assert(context.record == test_records);
+    assert(suite.executed_tests == 1);
+    assert(suite.failed_tests == 0);
+    assert(test.result == TRIC_OK);
+    assert(test.after == TRIC_OK);
+    assert(test_log_test_mock_data.count == 1);
+    assert(test_log_test_mock_data.test == &test);
+}
+
+
+
+void test_run_test_inline_fail(void) {
+    /* failing assert should jump back to the suite function */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST_WITH("test", .execution = TRIC_EXECUTE_INLINE);
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
+    volatile size_t jumps = 0;
+
+    if (tric_run_test(&context, false, false)) {
+        if (sigsetjmp(context.inline_test.jump, 1) != 0) {
+            jumps++;
+            tric_resume_inline(&context);
+        }
+    }
+    if (context.mode == MODE_EXECUTE) {
+        tric_fail(&context, __FILE__, 42);
+        assert(false);
+    }
+
+    assert(jumps == 1);
+    assert(context.mode == MODE_RESET);
+    assert(context.record == test_records);
+    assert(suite.failed_tests == 1);
+    assert(test.result == TRIC_FAILURE);
+    assert(test.line == 42);
+    assert(test_log_test_mock_data.count == 1);
+}
+
+
+
+void test_run_test_inline_signal(void) {
+    /* crashing test should jump back to the suite function */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
+    tric_execute(TRIC_EXECUTE_INLINE);
+
+    if (tric_run_test(&context, false, false)) {
+        if (sigsetjmp(context.inline_test.jump, 1) != 0) {
+            tric_resume_inline(&context);
+        }
+    }
+    tric_execute(TRIC_EXECUTE_DEFAULT);
+    if (context.mode == MODE_EXECUTE) {
+        raise(SIGSEGV);
+        assert(false);
+    }
+
+    assert(context.mode == MODE_RESET);
+    assert(suite.executed_tests == 1);
+    assert(suite.failed_tests == 1);
+    assert(test.result == TRIC_CRASHED);
+    assert(test.signal == SIGSEGV);
+    assert(tric_settings()->execution == TRIC_EXECUTE_FORK);
+}
+
+
+
+void test_run_before_inline(void) {
+    /* failing before function should finish test in the process of the test suite */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST_WITH("test", .execution = TRIC_EXECUTE_INLINE);
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+    test_before_mock_data.result = false;
+
+    assert(tric_run_test(&context, true, false));
+    tric_run_before(&context, test_before_mock, NULL);
+
+    assert(context.mode == MODE_RESET);
+    assert(context.record == test_records);
+    assert(suite.failed_tests == 1);
+    assert(test.before == TRIC_FAILURE);
+    assert(test.result == TRIC_SKIPPED);
+}
+
+
+
+void test_run_test_batch(void) {
+    /* tests should run in the same process until a test fails */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3") };
+    tests[0].id = 1;
+    tests[1].id = 2;
+    tests[2].id = 3;
+    tests[0].next = &tests[1];
+    tests[1].next = &tests[2];
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite, .record = test_records, .batch = { .size = 3 } };
+    tric_log(NULL, test_log_order_mock, NULL, NULL);
+    test_log_order_mock_data = (struct test_log_order_mock_data)TEST_LOG_ORDER_MOCK_DATA_NEW;
+    pid_t parent = getpid();
+
+    size_t i;
+    for (i = 0; i < 3; i++) {
+        tric_reset_context(&context, &tests[i]);
+        tric_run_test(&context, false, true);
+        if (context.mode == MODE_EXECUTE) {
+            assert(getpid() != parent);
+            context.mode = MODE_RESET;
+            if (i == 1) {
+                tric_fail(&context, __FILE__, 42);
+            }
+            tric_run_after(&context, NULL, NULL);
+        }
+    }
+    tric_end_batch(&context);
+
+    assert(getpid() == parent);
+    assert(context.record == test_records);
+    assert(context.batch.pending == 0);
+    assert(suite.executed_tests == 3);
+    assert(suite.failed_tests == 1);
+    assert(tests[0].result == TRIC_OK);
+    assert(tests[0].after == TRIC_OK);
+    assert(tests[1].result == TRIC_FAILURE);
+    assert(tests[1].after == TRIC_SKIPPED);
+    assert(tests[1].line == 42);
+    assert(tests[2].result == TRIC_OK);
+    assert(test_log_order_mock_data.count == 3);
+    assert(test_log_order_mock_data.ids[0] == 1);
+    assert(test_log_order_mock_data.ids[1] == 2);
+    assert(test_log_order_mock_data.ids[2] == 3);
+}
+
+
+
+void test_run_before_not(void) {
+    /* before function should not run */
+
+    struct tric_context context = { .mode = MODE_SCAN };
+    test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+
+    tric_run_before(&context, test_before_mock, &context);
+
+    assert(test_before_mock_data.count == 0);
+    assert(test_before_mock_data.data == NULL);
+}
+
+
+
+void test_run_before_null(void) {
+    /* nothing should run */
+
+    struct tric_context context = { .mode = MODE_EXECUTE };
+
+    int status;
+    pid_t child = fork();
+    assert(child != -1);
+    if (child) {
+        waitpid(child, &status, 0);
+    } else {
+        tric_run_before(&context, NULL, NULL);
+        _exit(EXIT_OK);
+    }
+
+    assert(WEXITSTATUS(status) == EXIT_OK);
+}
+
+
+
+void test_run_before_ok(void) {
+    /* before function should run */
+
+    struct tric_context context = { .mode = MODE_EXECUTE };
+    test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+
+    tric_run_before(&context, test_before_mock, &context);
+
+    assert(test_before_mock_data.count == 1);
+    assert(test_before_mock_data.data == &context);
+}
+
+
+
+void test_run_before_fail(void) {
+    /* failing before function should exit with failure status */
+
+    struct tric_context context = { .mode = MODE_EXECUTE, .record = test_records };
+    tric_reset_record(context.record);
+    test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+    test_before_mock_data.result = false;
+
+    int status;
+    pid_t child = fork();
+    assert(child != -1);
+    if (child) {
+        waitpid(child, &status, 0);
+    } else {
+        tric_run_before(&context, test_before_mock, NULL);
+        _exit(EXIT_OK);
+    }
+
+    assert(WEXITSTATUS(status) == EXIT_BEFORE_FAILURE);
+    assert(context.record->end.tv_sec != 0 || context.record->end.tv_nsec != 0);
+}
+
+
+
+void test_run_after_null(void) {
+    /* function should exit successfully */
+
+    struct tric_context context = { .record = test_records };
+    tric_reset_record(context.record);
+    int status;
+    pid_t child = fork();
+    assert(child != -1);
+    if (child) {
+        waitpid(child, &status, 0);
+    } else {
+        tric_run_after(&context, NULL, NULL);
+        _exit(EXIT_AFTER_FAILURE);
+    }
+
+    assert(context.record->end.tv_sec != 0 || context.record->end.tv_nsec != 0);
+    assert(WEXITSTATUS(status) == EXIT_OK);
+}
+
+
+
+void test_run_after_ok(void) {
+    /* function should exit successfully */
+
+    test_after_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+
+    struct tric_context context = { .record = test_records };
+    tric_reset_record(context.record);
+    int status;
+    pid_t child = fork();
+    assert(child != -1);
+    if (child) {
+        waitpid(child, &status, 0);
+    } else {
+        tric_run_after(&context, test_after_mock, NULL);
+        _exit(EXIT_AFTER_FAILURE);
+    }
+
+    assert(context.record->end.tv_sec != 0 || context.record->end.tv_nsec != 0);
+    assert(WEXITSTATUS(status) == EXIT_OK);
+}
+
+
+
+void test_run_after_fail(void) {
+    /* function should exit failure status */
+
+    test_after_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+    test_after_mock_data.result = false;
+
+    struct tric_context context = { .record = test_records };
+    tric_reset_record(context.record);
+    int status;
+    pid_t child = fork();
+    assert(child != -1);
+    if (child) {
+        waitpid(child, &status, 0);
+    } else {
+        tric_run_after(&context, test_after_mock, NULL);
+        _exit(EXIT_OK);
+    }
+
+    assert(context.record->end.tv_sec != 0 || context.record->end.tv_nsec != 0);
+    assert(WEXITSTATUS(status) == EXIT_AFTER_FAILURE);
+}
+
+
+
+void test_selected_id(void) {
+    /* IDs should be selected by lists and ranges */
+
+    assert(tric_selected_id("3", 3));
+    assert(tric_selected_id("3", 4) == false);
+    assert(tric_selected_id("1,3,5", 5));
+    assert(tric_selected_id("1,3,5", 4) == false);
+    assert(tric_selected_id("2-4", 2));
+    assert(tric_selected_id("2-4", 4));
+    assert(tric_selected_id("2-4", 5) == false);
+    assert(tric_selected_id("1,7-", 1000));
+    assert(tric_selected_id("1,7-", 6) == false);
+    assert(tric_selected_id("", 1) == false);
+    assert(tric_selected_id("x,2", 2));
+    assert(tric_selected_id("2x", 2) == false);
+}
+
+
+
+void test_is_selected(void) {
+    /* tests should be selected by their description and their ID */
+
+    struct tric_test test = NEW_TEST("parse number");
+    test.id = 3;
+    struct tric_context context = { .mode = MODE_EXECUTE, .test = &test };
+
+    assert(tric_is_selected(&context));
+    tric_settings()->filter = "parse*";
+    assert(tric_is_selected(&context));
+    tric_settings()->tests = "1-2";
+    assert(tric_is_selected(&context) == false);
+    tric_settings()->tests = "1-3";
+    assert(tric_is_selected(&context));
+    tric_settings()->filter = "*string";
+    assert(tric_is_selected(&context) == false);
+    tric_settings()->filter = NULL;
+    tric_settings()->tests = NULL;
+}
+
+
+
+void test_has_tag(void) {
+    /* tags should be found in a comma separated list */
+
+    assert(tric_has_tag("slow,io", "slow", 4));
+    assert(tric_has_tag("slow, io ", "io", 2));
+    assert(tric_has_tag("slow,io", "i", 1) == false);
+    assert(tric_has_tag("slower", "slow", 4) == false);
+    assert(tric_has_tag("", "slow", 4) == false);
+    assert(tric_has_tag(NULL, "slow", 4) == false);
+}
+
+
+
+void test_selected_tags(void) {
+    /* tags should be included and excluded */
+
+    assert(tric_selected_tags("!slow", NULL));
+    assert(tric_selected_tags("!slow", "io"));
+    assert(tric_selected_tags("!slow", "io,slow") == false);
+    assert(tric_selected_tags("io,bench", "io"));
+    assert(tric_selected_tags("io,bench", "slow") == false);
+    assert(tric_selected_tags("io,bench", NULL) == false);
+    assert(tric_selected_tags("io, !flaky", "io,flaky") == false);
+    assert(tric_selected_tags("io, !flaky", "io"));
+    assert(tric_selected_tags("", "io"));
+}
+
+
+
+void test_is_selected_tags(void) {
+    /* tests should be selected by their tags */
+
+    struct tric_test test = NEW_TEST_WITH("test", .tags = "slow,io");
+    struct tric_context context = { .mode = MODE_EXECUTE, .test = &test };
+
+    tric_settings()->tags = "io";
+    assert(tric_is_selected(&context));
+    tric_settings()->tags = "!slow";
+    assert(tric_is_selected(&context) == false);
+    tric_settings()->tags = NULL;
+    assert(tric_is_selected(&context));
+}
+
+
+
+void test_failed_result(void) {
+    /* failing, crashing, timed out and exceeding tests should have failed */
+
+    assert(tric_failed_result(TRIC_FAILURE));
+    assert(tric_failed_result(TRIC_CRASHED));
+    assert(tric_failed_result(TRIC_TIMEOUT));
+    assert(tric_failed_result(TRIC_EXCEEDED));
+    assert(tric_failed_result(TRIC_OK) == false);
+    assert(tric_failed_result(TRIC_SKIPPED) == false);
+    assert(tric_failed_result(TRIC_UNDEFINED) == false);
+}
+
+
+
+void test_is_selected_rerun_failed(void) {
+    /* only tests that failed before and new tests should be executed again */
+
+    struct tric_test test = NEW_TEST("test");
+    struct tric_context context = { .mode = MODE_EXECUTE, .test = &test };
+    tric_settings()->rerun_failed = true;
+
+    assert(tric_is_selected(&context));
+    test.previous_result = TRIC_CRASHED;
+    assert(tric_is_selected(&context));
+    test.previous_result = TRIC_OK;
+    assert(tric_is_selected(&context) == false);
+    tric_settings()->rerun_failed = false;
+    assert(tric_is_selected(&context));
+}
+
+
+
+void test_tagged_test(void) {
+    /* tags should be stored in the options of the test */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    struct tric_context *tric_context = &context;
+
+    TAGGED_TEST("test", "slow,bench", NULL, NULL, NULL) {
+    }
+
+    assert(suite.number_of_tests == 1);
+    assert(strcmp(suite.tests->options.tags, "slow,bench") == 0);
+}
+
+
+
+void test_run_test_not_selected(void) {
+    /* tests that are not selected should be skipped without creating a process */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    test.id = 2;
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
+    tric_settings()->tests = "1";
+    pid_t parent = getpid();
+
+    bool result = tric_run_test(&context, true, false);
+    tric_settings()->tests = NULL;
+
+    assert(getpid() == parent);
+    assert(result == false);
+    assert(context.mode == MODE_RESET);
+    assert(test.before == TRIC_SKIPPED);
+    assert(test.result == TRIC_SKIPPED);
+    assert(test.after == TRIC_UNDEFINED);
+    assert(suite.skipped_tests == 1);
+    assert(suite.executed_tests == 0);
+    assert(test_log_test_mock_data.count == 1);
+}
+
+
+
+void test_status_not_in_shard(void) {
+    /* test should be reported as not in shard */
+
+    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED };
+    struct tric_suite suite = { .skipped_tests = 0, .not_in_shard_tests = 0 };
+    struct tric_context context = { .suite = &suite, .test = &test };
+
+    tric_set_status(&context, EXIT_NOT_IN_SHARD, false, false);
+
+    assert(suite.not_in_shard_tests == 1);
+    assert(suite.skipped_tests == 0);
+    assert(test.before == TRIC_UNDEFINED);
+    assert(test.result == TRIC_NOT_IN_SHARD);
+    assert(test.after == TRIC_UNDEFINED);
+}
+
+
+
+void test_status_not_run(void) {
+    /* test should be reported as not run */
+
+    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED };
+    struct tric_suite suite = { .skipped_tests = 0, .not_run_tests = 0 };
+    struct tric_context context = { .suite = &suite, .test = &test };
+
+    tric_set_status(&context, EXIT_NOT_RUN, false, false);
+
+    assert(suite.not_run_tests == 1);
+    assert(suite.skipped_tests == 0);
+    assert(test.before == TRIC_UNDEFINED);
+    assert(test.result == TRIC_NOT_RUN);
+    assert(test.after == TRIC_UNDEFINED);
+}
+
+
+
+void test_status_deferred(void) {
+    /* test should be reported as deferred */
+
+    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED };
+    struct tric_suite suite = { .skipped_tests = 0, .deferred_tests = 0 };
+    struct tric_context context = { .suite = &suite, .test = &test };
+
+    tric_set_status(&context, EXIT_DEFERRED, false, false);
+
+    assert(suite.deferred_tests == 1);
+    assert(suite.skipped_tests == 0);
+    assert(test.before == TRIC_UNDEFINED);
+    assert(test.result == TRIC_DEFERRED);
+    assert(test.after == TRIC_UNDEFINED);
+}
+
+
+
+void test_in_shard(void) {
+    /* only tests of the selected shard should be executed */
+
+    struct tric_test test = NEW_TEST("test");
+    struct tric_context context = { .test = &test };
+    test.shard = 1;
+
+    assert(tric_in_shard(&context));
+    tric_settings()->shard_count = 3;
+    assert(tric_in_shard(&context) == false);
+    tric_settings()->shard_index = 1;
+    assert(tric_in_shard(&context));
+    tric_settings()->shard_count = 1;
+    tric_settings()->shard_index = 0;
+}
+
+
+
+void test_shard_index(void) {
+    /* shard index should start at 0 */
+
+    assert(tric_shard_index(NULL) == 0);
+    assert(tric_shard_index("0") == 0);
+    assert(tric_shard_index("3") == 3);
+    assert(tric_shard_index("-1") == SIZE_MAX);
+    assert(tric_shard_index("2x") == SIZE_MAX);
+    assert(tric_shard_index("x") == SIZE_MAX);
+    assert(tric_shard_index("") == SIZE_MAX);
+}
+
+
+
+void test_assign_shards_id(void) {
+    /* tests without durations should be distributed by their ID */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3"), NEW_TEST("4"), NEW_TEST("5") };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    size_t i;
+    for (i = 0; i < 5; i++) {
+        tric_add_test(&context, &tests[i]);
+    }
+
+    tric_assign_shards(&suite, 2);
+
+    assert(tests[0].shard == 0);
+    assert(tests[1].shard == 1);
+    assert(tests[2].shard == 0);
+    assert(tests[3].shard == 1);
+    assert(tests[4].shard == 0);
+}
+
+
+
+void test_assign_shards_duration(void) {
+    /* longest tests should be assigned first to the shard with the least total duration */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3"), NEW_TEST("4"), NEW_TEST("5") };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    size_t i;
+    for (i = 0; i < 5; i++) {
+        tric_add_test(&context, &tests[i]);
+    }
+    tests[0].previous_duration = 1;
+    tests[1].previous_duration = 8;
+    tests[2].previous_duration = 3;
+    tests[3].previous_duration = 4;
+
+    tric_assign_shards(&suite, 2);
+
+    assert(tests[1].shard == 0);
+    assert(tests[3].shard == 1);
+    assert(tests[4].shard == 1);
+    assert(tests[2].shard == 0);
+    assert(tests[0].shard == 1);
+}
+
+
+
+void test_result_name(void) {
+    /* result names should be mapped to results */
+
+    assert(strcmp(tric_result_name(TRIC_NOT_IN_SHARD), "not_in_shard") == 0);
+    assert(tric_result_value("failure") == TRIC_FAILURE);
+    assert(tric_result_value("not_in_shard") == TRIC_NOT_IN_SHARD);
+    assert(tric_result_value("not_run") == TRIC_NOT_RUN);
+    assert(tric_result_value("deferred") == TRIC_DEFERRED);
+    assert(tric_result_value("unknown") == TRIC_UNDEFINED);
+}
+
+
+
+void test_history(void) {
+    /* results and durations should be read back from the history file */
+
+    char path[] = "/tmp/tric_history_XXXXXX";
+    int file = mkstemp(path);
+    assert(file != -1);
+    assert(write(file, "other\t1\tok\t5.0\tother test\n", 27) == 27);
+    close(file);
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("first"), NEW_TEST("second"), NEW_TEST("third") };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    size_t i;
+    for (i = 0; i < 3; i++) {
+        tric_add_test(&context, &tests[i]);
+    }
+    tric_store_tests(&suite);
+    suite.table[0].result = TRIC_OK;
+    suite.table[0].duration = 0.5;
+    suite.table[1].result = TRIC_FAILURE;
+    suite.table[1].duration = 2;
+    suite.table[2].result = TRIC_SKIPPED;
+
+    tric_write_history(&suite, path);
+    suite.table[1].description = "renamed";
+    tric_read_history(&suite, path);
+
+    assert(suite.table[0].previous_result == TRIC_OK);
+    assert(suite.table[0].previous_duration == 0.5);
+    assert(suite.table[1].previous_result == TRIC_UNDEFINED);
+    assert(suite.table[1].previous_duration == -1);
+    assert(suite.table[2].previous_result == TRIC_UNDEFINED);
+    FILE *history = fopen(path, "r");
+    char line[64];
+    assert(fgets(line, sizeof(line), history) != NULL);
+    assert(strcmp(line, "other\t1\tok\t5.0\tother test\n") == 0);
+    fclose(history);
+    remove(path);
+    free(suite.table);
+}
+
+
+
+void test_history_deferred(void) {
+    /* deferred tests should be recorded as deferred unless they failed before */
+
+    char path[] = "/tmp/tric_history_XXXXXX";
+    int file = mkstemp(path);
+    assert(file != -1);
+    close(file);
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("first"), NEW_TEST("second"), NEW_TEST("third") };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    size_t i;
+    for (i = 0; i < 3; i++) {
+        tric_add_test(&context, &tests[i]);
+        tests[i].result = TRIC_DEFERRED;
+        tests[i].previous_duration = 1;
+    }
+    tric_store_tests(&suite);
+    suite.table[0].previous_result = TRIC_OK;
+    suite.table[1].previous_result = TRIC_FAILURE;
+
+    tric_write_history(&suite, path);
+    tric_read_history(&suite, path);
+
+    assert(suite.table[0].previous_result == TRIC_DEFERRED);
+    assert(suite.table[0].previous_duration == 1);
+    assert(suite.table[1].previous_result == TRIC_FAILURE);
+    assert(suite.table[2].previous_result == TRIC_UNDEFINED);
+    remove(path);
+    free(suite.table);
+}
+
+
+
+void test_history_shards(void) {
+    /* shards executed one after another on the same history file should execute each test once */
+
+    char path[] = "/tmp/tric_history_XXXXXX";
+    int file = mkstemp(path);
+    assert(file != -1);
+    close(file);
+    size_t runs[6] = { 0 };
+    size_t run;
+    for (run = 0; run < 3; run++) {
+        struct tric_suite suite = NEW_SUITE("test suite");
+        struct tric_test tests[] = { NEW_TEST("a"), NEW_TEST("b"), NEW_TEST("c"), NEW_TEST("d"), NEW_TEST("e"), NEW_TEST("f") };
+        struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+        size_t i;
+        for (i = 0; i < 6; i++) {
+            tric_add_test(&context, &tests[i]);
+        }
+        tric_store_tests(&suite);
+        /* the first run records durations without shards, the shards change the durations */
+        tric_settings()->shard_count = run > 0 ? 2 : 1;
+        tric_settings()->shard_index = run > 0 ? run - 1 : 0;
+        tric_read_history(&suite, path);
+        tric_assign_shards(&suite, tric_settings()->shard_count);
+        for (i = 0; i < 6; i++) {
+            context.test = &suite.table[i];
+            suite.table[i].result = tric_in_shard(&context) ? TRIC_OK : TRIC_NOT_IN_SHARD;
+            suite.table[i].duration = run == 1 ? 10 - i : i + 1;
+            if (run > 0 && tric_in_shard(&context)) {
+                runs[i]++;
+            }
+        }
+        tric_write_history(&suite, path);
+        free(suite.table);
+    }
+    tric_settings()->shard_count = 1;
+    tric_settings()->shard_index = 0;
+
+    size_t i;
+    for (i = 0; i < 6; i++) {
+        assert(runs[i] == 1);
+    }
+    remove(path);
+}
+
+
+
+void test_history_missing(void) {
+    /* missing history file should be ignored */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+
+    tric_read_history(&suite, "/nonexistent/tric_history");
+    tric_read_history(&suite, NULL);
+    tric_write_history(&suite, NULL);
+}
+
+
+
+void test_run_test_not_in_shard(void) {
+    /* tests of other shards should be reported without creating a process */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    test.shard = 1;
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
+    tric_settings()->shard_count = 2;
+    pid_t parent = getpid();
+
+    bool result = tric_run_test(&context, false, false);
+    tric_settings()->shard_count = 1;
+
+    assert(getpid() == parent);
+    assert(result == false);
+    assert(context.mode == MODE_RESET);
+    assert(test.result == TRIC_NOT_IN_SHARD);
+    assert(suite.not_in_shard_tests == 1);
+    assert(suite.executed_tests == 0);
+    assert(test_log_test_mock_data.count == 1);
+}
+
+
+
+void test_stopped(void) {
+    /* test suite should be stopped after the maximum number of failed tests */
+
+    struct tric_suite suite = { .failed_tests = 1 };
+    struct tric_context context = { .suite = &suite };
+
+    assert(tric_stopped(&context) == false);
+    tric_settings()->max_failures = 2;
+    assert(tric_stopped(&context) == false);
+    suite.failed_tests = 2;
+    assert(tric_stopped(&context));
+    tric_settings()->max_failures = 0;
+    assert(tric_stopped(&context) == false);
+}
+
+
+
+void test_run_test_stopped(void) {
+    /* tests should not be executed after the test suite was stopped */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    suite.failed_tests = 1;
+    struct tric_test test = NEW_TEST("test");
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
+    tric_settings()->max_failures = 1;
+    pid_t parent = getpid();
+
+    bool result = tric_run_test(&context, false, false);
+    tric_settings()->max_failures = 0;
+
+    assert(getpid() == parent);
+    assert(result == false);
+    assert(context.mode == MODE_RESET);
+    assert(test.result == TRIC_NOT_RUN);
+    assert(suite.not_run_tests == 1);
+    assert(suite.executed_tests == 0);
+    assert(test_log_test_mock_data.count == 1);
+}
+
+
+
+void test_run_test_parallel_failure(void) {
+    /* each failing test running in parallel should report its own line */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3") };
+    struct tric_job entries[3];
+    struct tric_queue queue = { .jobs = 3, .capacity = 3, .entries = entries };
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite, .records = test_records, .number_of_records = TEST_RECORDS_SIZE, .queue = &queue };
+    memset(test_records, 0, TEST_RECORDS_SIZE * sizeof(struct tric_record));
+    tric_log(NULL, test_log_order_mock, NULL, NULL);
+    test_log_order_mock_data = (struct test_log_order_mock_data)TEST_LOG_ORDER_MOCK_DATA_NEW;
+    pid_t parent = getpid();
+
+    size_t i;
+    for (i = 0; i < 3; i++) {
+        context.mode = MODE_EXECUTE;
+        context.test = &tests[i];
+        tric_run_test(&context, false, false);
+        if (context.mode == MODE_EXECUTE) {
+            assert(getpid() != parent);
+            usleep((3 - i) * 20000);
+            tric_fail(&context, "file", 100 + i);
+        }
+    }
+    tric_finish_jobs(&context);
+
+    assert(suite.failed_tests == 3);
+    for (i = 0; i < 3; i++) {
+        assert(tests[i].result == TRIC_FAILURE);
+        assert(tests[i].line == 100 + i);
+        assert(strcmp(tests[i].file, "file") == 0);
+    }
+}
+
+
+
+void test_run_test_parallel_stopped(void) {
+    /* running tests should be terminated and reported as not run after the test suite was stopped */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3") };
+    tests[0].id = 1;
+    tests[1].id = 2;
+    tests[2].id = 3;
+    struct tric_job entries[3];
+    struct tric_queue queue = { .jobs = 2, .capacity = 3, .entries = entries };
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite, .records = test_records, .number_of_records = TEST_RECORDS_SIZE, .queue = &queue };
+    memset(test_records, 0, TEST_RECORDS_SIZE * sizeof(struct tric_record));
+    tric_log(NULL, test_log_order_mock, NULL, NULL);
+    test_log_order_mock_data = (struct test_log_order_mock_data)TEST_LOG_ORDER_MOCK_DATA_NEW;
+    tric_settings()->max_failures = 1;
+    pid_t parent = getpid();
+
+    size_t i;
+    for (i = 0; i < 3; i++) {
+        context.mode = MODE_EXECUTE;
+        context.test = &tests[i];
+        tric_run_test(&context, false, false);
+        if (context.mode == MODE_EXECUTE) {
+            assert(getpid() != parent);
+            if (i == 0) {
+                sleep(10);
+            }
+            _exit(EXIT_TEST_FAILURE);
+        }
+    }
+    tric_finish_jobs(&context);
+    tric_settings()->max_failures = 0;
+
+    assert(queue.running == 0);
+    assert(queue.length == 0);
+    assert(suite.executed_tests == 1);
+    assert(suite.failed_tests == 1);
+    assert(suite.not_run_tests == 2);
+    assert(tests[0].result == TRIC_NOT_RUN);
+    assert(tests[0].signal == 0);
+    assert(tests[1].result == TRIC_FAILURE);
+    assert(tests[2].result == TRIC_NOT_RUN);
+    assert(test_log_order_mock_data.count == 3);
+    assert(test_log_order_mock_data.ids[0] == 1);
+    assert(test_log_order_mock_data.ids[1] == 2);
+    assert(test_log_order_mock_data.ids[2] == 3);
+}
+
+
+
+void test_run_test_held(void) {
+    /* held tests should be started in the order of their ranks and reported in the order of the test suite */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3") };
+    tests[0].id = 1;
+    tests[1].id = 2;
+    tests[2].id = 3;
+    size_t ranks[] = { 2, 1, 0 };
+    struct tric_job entries[3];
+    struct tric_queue queue = { .jobs = 2, .capacity = 3, .entries = entries, .ranks = ranks };
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite, .records = test_records, .number_of_records = TEST_RECORDS_SIZE, .queue = &queue };
+    memset(test_records, 0, TEST_RECORDS_SIZE * sizeof(struct tric_record));
+    tric_log(NULL, test_log_order_mock, NULL, NULL);
+    test_log_order_mock_data = (struct test_log_order_mock_data)TEST_LOG_ORDER_MOCK_DATA_NEW;
+    int started[2];
+    assert(pipe(started) == 0);
+
+    size_t i;
+    for (i = 0; i < 3; i++) {
+        context.mode = MODE_EXECUTE;
+        context.test = &tests[i];
+        tric_run_test(&context, false, false);
+        if (context.mode == MODE_EXECUTE) {
+            char id = (char)tests[i].id;
+            assert(write(started[1], &id, 1) == 1);
+            usleep(20000);
+            _exit(EXIT_OK);
+        }
+    }
+
+    assert(queue.held == 3);
+    assert(queue.running == 0);
+    assert(suite.executed_tests == 0);
+
+    tric_finish_jobs(&context);
+    close(started[1]);
+    char order[4];
+
+    assert(read(started[0], order, sizeof(order)) == 3);
+    assert(order[2] == 1);
+    assert(queue.held == 0);
+    assert(queue.length == 0);
+    assert(suite.executed_tests == 3);
+    assert(tests[0].result == TRIC_OK);
+    assert(tests[2].result == TRIC_OK);
+    assert(test_log_order_mock_data.count == 3);
+    assert(test_log_order_mock_data.ids[0] == 1);
+    assert(test_log_order_mock_data.ids[1] == 2);
+    assert(test_log_order_mock_data.ids[2] == 3);
+    close(started[0]);
+}
+
+
+
+void test_run_test_held_fixture(void) {
+    /* held tests should see the data prepared by the fixture block before them, which runs only once */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3") };
+    tests[0].id = 1;
+    tests[1].id = 2;
+    tests[2].id = 3;
+    size_t ranks[] = { 2, 1, 0 };
+    struct tric_job entries[3];
+    struct tric_queue queue = { .jobs = 2, .capacity = 3, .entries = entries, .ranks = ranks };
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite, .records = test_records, .number_of_records = TEST_RECORDS_SIZE, .records_file = -1, .queue = &queue };
+    struct tric_context *tric_context = &context;
+    memset(test_records, 0, TEST_RECORDS_SIZE * sizeof(struct tric_record));
+    tric_log(NULL, test_log_order_mock, NULL, NULL);
+    test_log_order_mock_data = (struct test_log_order_mock_data)TEST_LOG_ORDER_MOCK_DATA_NEW;
+    int value = 0;
+    size_t count = 0;
+
+    FIXTURE("prepare") {
+        value = 42;
+        count++;
+    }
+    size_t i;
+    for (i = 0; i < 3; i++) {
+        context.mode = MODE_EXECUTE;
+        context.test = &tests[i];
+        tric_run_test(&context, false, false);
+        if (context.mode == MODE_EXECUTE) {
+            _exit(value == 42 ? EXIT_OK : EXIT_TEST_FAILURE);
+        }
+    }
+    FIXTURE("clean up") {
+        value = 0;
+    }
+
+    assert(count == 1);
+    assert(value == 0);
+    assert(queue.held == 0);
+    assert(queue.running == 0);
+    assert(suite.executed_tests == 3);
+    assert(suite.failed_tests == 0);
+    assert(test_log_order_mock_data.count == 3);
+}
+
+
+
+void test_run_test_held_sequential(void) {
+    /* with a single job, held tests should be started one after another in the order of their ranks after the fixture block before them */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3") };
+    tests[0].id = 1;
+    tests[1].id = 2;
+    tests[2].id = 3;
+    size_t ranks[] = { 1, 2, 0 };
+    struct tric_job entries[3];
+    struct tric_queue queue = { .jobs = 1, .capacity = 3, .entries = entries, .ranks = ranks };
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite, .records = test_records, .number_of_records = TEST_RECORDS_SIZE, .records_file = -1, .queue = &queue };
+    struct tric_context *tric_context = &context;
+    memset(test_records, 0, TEST_RECORDS_SIZE * sizeof(struct tric_record));
+    tric_log(NULL, test_log_order_mock, NULL, NULL);
+    test_log_order_mock_data = (struct test_log_order_mock_data)TEST_LOG_ORDER_MOCK_DATA_NEW;
+    int started[2];
+    assert(pipe(started) == 0);
+    int value = 0;
+
+    FIXTURE("prepare") {
+        value = 42;
+    }
+    size_t i;
+    for (i = 0; i < 3; i++) {
+        context.mode = MODE_EXECUTE;
+        context.test = &tests[i];
+        tric_run_test(&context, false, false);
+        if (context.mode == MODE_EXECUTE) {
+            char id = (char)tests[i].id;
+            assert(write(started[1], &id, 1) == 1);
+            _exit(value == 42 ? EXIT_OK : EXIT_TEST_FAILURE);
+        }
+    }
+    tric_finish_jobs(&context);
+    close(started[1]);
+    char order[4];
+
+    assert(read(started[0], order, sizeof(order)) == 3);
+    assert(order[0] == 3);
+    assert(order[1] == 1);
+    assert(order[2] == 2);
+    assert(suite.executed_tests == 3);
+    assert(suite.failed_tests == 0);
+    assert(test_log_order_mock_data.count == 3);
+    assert(test_log_order_mock_data.ids[0] == 1);
+    assert(test_log_order_mock_data.ids[2] == 3);
+    close(started[0]);
+}
+
+
+
+void test_max_failures(void) {
+    /* maximum number of failures should be read as number, 0 if not set or invalid */
+
+    assert(tric_max_failures("1") == 1);
+    assert(tric_max_failures("0") == 0);
+    assert(tric_max_failures(NULL) == 0);
+    assert(tric_max_failures("") == 0);
+    assert(tric_max_failures("-1") == 0);
+    assert(tric_max_failures("1x") == 0);
+}
+
+
+
+void test_time_budget(void) {
+    /* time budget should be read in seconds or minutes, 0 if not set or invalid */
+
+    assert(tric_time_budget("120") == 120);
+    assert(tric_time_budget("1.5s") == 1.5);
+    assert(tric_time_budget("2m") == 120);
+    assert(tric_time_budget(NULL) == 0);
+    assert(tric_time_budget("") == 0);
+    assert(tric_time_budget("0") == 0);
+    assert(tric_time_budget("-1") == 0);
+    assert(tric_time_budget("1h") == 0);
+    assert(tric_time_budget("s") == 0);
+}
+
+
+
+void test_defer_tests(void) {
+    /* failed, new and deferred tests should be preferred and tests that do not fit should be deferred */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3"), NEW_TEST("4"), NEW_TEST("5"), NEW_TEST("6") };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    size_t i;
+    for (i = 0; i < 6; i++) {
+        tric_add_test(&context, &tests[i]);
+        tests[i].previous_result = TRIC_OK;
+    }
+    tests[0].previous_duration = 1;
+    tests[1].previous_duration = 2;
+    tests[2].previous_result = TRIC_DEFERRED;
+    tests[2].previous_duration = 2;
+    tests[3].previous_result = TRIC_UNDEFINED;
+    tests[4].previous_result = TRIC_CRASHED;
+    tests[4].previous_duration = 3;
+    tests[5].previous_duration = 0.5;
+
+    tric_defer_tests(&suite, 4, 2);
+
+    assert(tests[4].deferred == false);
+    assert(tests[3].deferred == false);
+    assert(tests[2].deferred == false);
+    assert(tests[5].deferred == false);
+    assert(tests[0].deferred);
+    assert(tests[1].deferred);
+}
+
+
+
+void test_defer_tests_none(void) {
+    /* no test should be deferred without time budget */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    tric_add_test(&context, &test);
+    test.previous_duration = 10;
+
+    tric_defer_tests(&suite, 0, 1);
+    assert(test.deferred == false);
+    assert(test.over_budget == false);
+}
+
+
+
+void test_defer_tests_over_budget(void) {
+    /* tests longer than the budget should be executed in turn, one in each run, and a failed one first */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3"), NEW_TEST("4") };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    size_t i;
+    for (i = 0; i < 4; i++) {
+        tric_add_test(&context, &tests[i]);
+    }
+    tests[0].previous_result = TRIC_OK;
+    tests[0].previous_duration = 20;
+    tests[1].previous_result = TRIC_DEFERRED;
+    tests[1].previous_duration = 30;
+    tests[2].previous_result = TRIC_OK;
+    tests[2].previous_duration = 1;
+    tests[3].previous_result = TRIC_DEFERRED;
+    tests[3].previous_duration = 10;
+
+    tric_defer_tests(&suite, 5, 4);
+
+    assert(tests[0].deferred);
+    assert(tests[1].deferred == false);
+    assert(tests[1].over_budget);
+    assert(tests[2].deferred == false);
+    assert(tests[2].over_budget == false);
+    assert(tests[3].deferred);
+
+    tric_settings()->time_budget = 5;
+    struct tric_context run = { .suite = &suite, .test = &tests[1] };
+    clock_gettime(CLOCK_MONOTONIC, &run.start);
+    assert(tric_deferred(&run) == false);
+    tric_settings()->time_budget = 0;
+
+    for (i = 0; i < 4; i++) {
+        tests[i].previous_result = tests[i].deferred ? TRIC_DEFERRED : TRIC_OK;
+        tests[i].deferred = false;
+        tests[i].over_budget = false;
+    }
+    tric_defer_tests(&suite, 5, 4);
+
+    assert(tests[3].over_budget);
+    assert(tests[0].deferred);
+    assert(tests[1].deferred);
+
+    tests[1].previous_result = TRIC_FAILURE;
+    tests[3].over_budget = false;
+    tric_defer_tests(&suite, 5, 4);
+
+    assert(tests[1].over_budget);
+}
+
+
+
+void test_deferred(void) {
+    /* tests should be deferred if selected so or if their previous duration exceeds the remaining time */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    struct tric_context context = { .suite = &suite, .test = &test };
+    clock_gettime(CLOCK_MONOTONIC, &context.start);
+    test.deferred = true;
+
+    assert(tric_deferred(&context) == false);
+    tric_settings()->time_budget = 10;
+    assert(tric_deferred(&context));
+    test.deferred = false;
+    assert(tric_deferred(&context) == false);
+    test.previous_duration = 20;
+    assert(tric_deferred(&context));
+    context.start.tv_sec -= 20;
+    test.previous_duration = -1;
+    assert(tric_deferred(&context));
+    tric_settings()->time_budget = 0;
+}
+
+
+
+void test_run_test_deferred(void) {
+    /* deferred tests should be reported without creating a process */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    test.deferred = true;
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .record = test_records };
+    clock_gettime(CLOCK_MONOTONIC, &context.start);
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
+    tric_settings()->time_budget = 10;
+    pid_t parent = getpid();
+
+    bool result = tric_run_test(&context, false, false);
+    tric_settings()->time_budget = 0;
+
+    assert(getpid() == parent);
+    assert(result == false);
+    assert(context.mode == MODE_RESET);
+    assert(test.result == TRIC_DEFERRED);
+    assert(suite.deferred_tests == 1);
+    assert(suite.executed_tests == 0);
+    assert(test_log_test_mock_data.count == 1);
+}
+
+
+
+void test_skip_test_execution_not(void) {
+    /* status should not be set */
+
+    struct tric_suite suite = { .skipped_tests = 0 };
+    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = &test };
+
+    tric_skip_test_execution(&context, NULL, NULL);
+
+    assert(suite.skipped_tests == 0);
+    assert(test.before == TRIC_UNDEFINED);
+    assert(test.result == TRIC_UNDEFINED);
+    assert(test.after == TRIC_UNDEFINED);
+    assert(context.mode == MODE_SCAN);
+}
+
+
+
+void test_skip_test_execution_not_in_shard(void) {
+    /* skipped tests of other shards should be reported as not in shard */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    test.shard = 1;
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test };
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    tric_settings()->shard_count = 2;
+
+    tric_skip_test_execution(&context, NULL, NULL);
+    tric_settings()->shard_count = 1;
+
+    assert(suite.skipped_tests == 0);
+    assert(suite.not_in_shard_tests == 1);
+    assert(test.result == TRIC_NOT_IN_SHARD);
+    assert(context.mode == MODE_RESET);
+}
+
+
+
+void test_skip_test_execution_spawned(void) {
+    /* other tests should be ignored by a spawned process */
+
+    struct tric_suite suite = { .skipped_tests = 0 };
+    struct tric_test test = NEW_TEST("test");
+    test.id = 1;
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test, .spawned = 2 };
+
+    tric_skip_test_execution(&context, NULL, NULL);
+
+    assert(suite.skipped_tests == 0);
+    assert(test.result == TRIC_UNDEFINED);
+    assert(context.mode == MODE_RESET);
+}
+
+
+
+void test_skip_test_execution_ok(void) {
+    /* skipped status should be set and mode should be reset */
+
+    struct tric_suite suite = { .skipped_tests = 0 };
+    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED };
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test };
+    test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+    test_after_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+    tric_log(NULL, test_log_test_mock, NULL, &context);
+    test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
+
+    tric_skip_test_execution(&context, test_before_mock, test_after_mock);
+
+    assert(suite.skipped_tests == 1);
+    assert(test.before == TRIC_SKIPPED);
+    assert(test.result == TRIC_SKIPPED);
+    assert(test.after == TRIC_SKIPPED);
+    assert(test_before_mock_data.count == 0);
+    assert(test_after_mock_data.count == 0);
+    assert(test_log_test_mock_data.count == 1);
+    assert(test_log_test_mock_data.suite == &suite);
+    assert(test_log_test_mock_data.test == &test);
+    assert(test_log_test_mock_data.data == &context);
+    assert(context.mode == MODE_RESET);
+}
+
+
+
+void test_skip_test_execution_parallel(void) {
+    /* skipped test should be reported after running test */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2") };
+    tests[0].id = 1;
+    tests[1].id = 2;
+    struct tric_job entries[2];
+    struct tric_queue queue = { .jobs = 2, .capacity = 2, .entries = entries };
+    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &tests[0], .records = test_records, .number_of_records = TEST_RECORDS_SIZE, .queue = &queue };
+    memset(test_records, 0, TEST_RECORDS_SIZE * sizeof(struct tric_record));
+    tric_log(NULL, test_log_order_mock, NULL, NULL);
+    test_log_order_mock_data = (struct test_log_order_mock_data)TEST_LOG_ORDER_MOCK_DATA_NEW;
+
+    tric_run_test(&context, false, false);
+    if (context.mode == MODE_EXECUTE) {
+        usleep(20000);
+        _exit(EXIT_OK);
+    }
+    context.mode = MODE_EXECUTE;
+    context.test = &tests[1];
+    tric_skip_test_execution(&context, NULL, NULL);
+
+    assert(suite.skipped_tests == 1);
+    assert(tests[1].result == TRIC_SKIPPED);
+    assert(test_log_order_mock_data.count == 0);
+
+    tric_finish_jobs(&context);
+
+    assert(test_log_order_mock_data.count == 2);
+    assert(test_log_order_mock_data.ids[0] == 1);
+    assert(test_log_order_mock_data.ids[1] == 2);
+}
+
+
+
+void test_reporting_all(void) {
+    /* all logging functions should be set */
+
+    /* ensure default configuration */
+    tric_reporting(true, tric_log_start, tric_log_test, tric_log_end, NULL);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == tric_log_start);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == tric_log_test);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == tric_log_end);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == NULL);
+
+    void *test_reference = NULL;
+    tric_reporting(true, test_log_start_mock, test_log_test_mock, test_log_end_mock, &test_reference);
+
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == test_log_start_mock);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == test_log_test_mock);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == test_log_end_mock);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == &test_reference);
+}
+
+
+
+void test_reporting_none(void) {
+    /* logging functions should be set to no logger */
+
+    /* ensure default configuration */
+    tric_reporting(true, tric_log_start, tric_log_test, tric_log_end, NULL);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == tric_log_start);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == tric_log_test);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == tric_log_end);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == NULL);
+
+    tric_reporting(true, NULL, NULL, NULL, NULL);
+
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == tric_log_nothing);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == tric_log_nothing);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == tric_log_nothing);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == NULL);
+}
+
+
+
+void test_report(void) {
+    /* logger functions should be accessible */
+
+    /* ensure default configuration */
+    tric_reporting(true, tric_log_start, tric_log_test, tric_log_end, NULL);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == tric_log_start);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == tric_log_test);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == tric_log_end);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == NULL);
+
+    struct tric_reporting_data *result = tric_report();
+
+    assert(result->start == tric_log_start);
+    assert(result->test == tric_log_test);
+    assert(result->end == tric_log_end);
+    assert(result->data == NULL);
+}
+
+
+
+void test_log(void) {
+    /* all logger functions should be set */
+
+    /* ensure default configuration */
+    tric_reporting(true, tric_log_start, tric_log_test, tric_log_end, NULL);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == tric_log_start);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == tric_log_test);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == tric_log_end);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == NULL);
+
+    void *test_reference = NULL;
+    tric_log(test_log_start_mock, test_log_test_mock, test_log_end_mock, &test_reference);
+
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == test_log_start_mock);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == test_log_test_mock);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == test_log_end_mock);
+    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == &test_reference);
+}
+
+
+
+void test_run_fixture_not(void) {
+    // no fixture to execute should be ok */
+
+    bool result = tric_run_fixture(NULL, NULL);
+
+    assert(result == true);
+}
+
+
+
+void test_run_fixture_ok(void) {
+    /* successfully run fixture should return true */
+
+    test_setup_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+
+    void *test_reference = NULL;
+    bool result = tric_run_fixture(test_setup_mock, &test_reference);
+
+    assert(result == true);
+    assert(test_setup_mock_data.count == 1);
+    assert(test_setup_mock_data.data == &test_reference);
+}
+
+
+
+void test_run_fixture_fail(void) {
+    /* failing fixture should return false */
+
+    test_setup_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+    test_setup_mock_data.result = false;
+
+    void *test_reference = NULL;
+    bool result = tric_run_fixture(test_setup_mock, &test_reference);
+
+    assert(result == false);
+    assert(test_setup_mock_data.count == 1);
+    assert(test_setup_mock_data.data == &test_reference);
+}
+
+
+
+void test_scan_tests(void) {
+    /* suite function should execute scan */
+
+    struct tric_suite suite;
+    struct tric_test test;
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite, .test = &test };
+    test_suite_mock_data = (struct test_suite_mock_data)TEST_SUITE_MOCK_DATA_NEW;
+
+    tric_scan_tests(&context);
+
+    assert(test_suite_mock_data.count == 1);
+    assert(test_suite_mock_data.context_mode == MODE_SCAN);
+    assert(test_suite_mock_data.context_suite == &suite);
+    assert(test_suite_mock_data.context_reference == &context);
+    assert(context.mode == MODE_RESET);
+    assert(context.test == NULL);
+}
+
+
+
+void test_register_tests(void) {
+    /* tests of the linker section should be added in the order of their positions */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3") };
+    struct tric_entry entries[] = { { .test = &tests[1], .order = 20 }, { .test = &tests[2], .order = 30 }, { .test = &tests[0], .order = 10 } };
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite };
+
+    bool result = tric_register_tests(&context, entries, entries + 3);
+
+    assert(result);
+    assert(context.mode == MODE_RESET);
+    assert(suite.number_of_tests == 3);
+    assert(suite.tests == &tests[0]);
+    assert(tests[0].next == &tests[1]);
+    assert(tests[1].next == &tests[2]);
+    assert(tests[2].next == NULL);
+    assert(tests[0].id == 1);
+    assert(tests[1].id == 2);
+    assert(tests[2].id == 3);
+}
+
+
+
+void test_register_tests_empty(void) {
+    /* empty linker section should not add tests */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_entry entries[1];
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite };
+
+    assert(tric_register_tests(&context, NULL, NULL) == false);
+    assert(tric_register_tests(&context, entries, entries) == false);
+    assert(suite.number_of_tests == 0);
+    assert(suite.tests == NULL);
+}
+
+
+
+void test_find_tests(void) {
+    /* suite should be scanned if no tests are registered */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_context context = { .mode = MODE_RESET, .suite = &suite };
+    test_suite_mock_data = (struct test_suite_mock_data)TEST_SUITE_MOCK_DATA_NEW;
+
+    tric_find_tests(&context);
+
+    assert(context.mode == MODE_RESET);
+    assert(test_suite_mock_data.count == 1);
+    assert(test_suite_mock_data.context_mode == MODE_SCAN);
+}
+
+
+
+void test_store_tests(void) {
+    /* tests should be moved into a table in the order of their IDs */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3") };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    tric_add_test(&context, &tests[2]);
+    tric_add_test(&context, &tests[0]);
+    tric_add_test(&context, &tests[1]);
+
+    tric_store_tests(&suite);
+
+    assert(suite.table != NULL);
+    assert(suite.tests == suite.table);
+    assert(suite.table[0].id == 1);
+    assert(strcmp(suite.table[0].description, "3") == 0);
+    assert(suite.table[0].next == &suite.table[1]);
+    assert(suite.table[1].next == &suite.table[2]);
+    assert(suite.table[2].next == NULL);
+    assert(strcmp(suite.table[2].description, "2") == 0);
+    free(suite.table);
+}
+
+
+
+void test_store_tests_empty(void) {
+    /* no table should be allocated without tests */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+
+    tric_store_tests(&suite);
+
+    assert(suite.table == NULL);
+    assert(suite.tests == NULL);
+}
+
+
+
+void test_free_tests(void) {
+    /* table and tests created for each case should be freed */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test test = NEW_TEST("test");
+    struct tric_each each = { .description = "case", .count = 0, .tests = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    tric_add_test(&context, &test);
+    tric_add_each(&context, &each, 3);
+    tric_store_tests(&suite);
+
+    assert(suite.table[1].description == (char *)(each.tests + 3));
+
+    tric_free_tests(&suite);
+
+    assert(suite.table == NULL);
+    assert(suite.tests == NULL);
+    tric_free_tests(&suite);
+}
+
+
+
+void test_suite_test(void) {
+    /* tests should be found by their ID with and without table */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2") };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    tric_add_test(&context, &tests[0]);
+    tric_add_test(&context, &tests[1]);
+
+    assert(tric_suite_test(&suite, 0) == NULL);
+    assert(tric_suite_test(&suite, 2) == &tests[1]);
+    assert(tric_suite_test(&suite, 3) == NULL);
+
+    tric_store_tests(&suite);
+
+    assert(tric_suite_test(&suite, 1) == &suite.table[0]);
+    assert(tric_suite_test(&suite, 2) == &suite.table[1]);
+    assert(tric_suite_test(&suite, 3) == NULL);
+    free(suite.table);
+}
+
+
+
+void test_reset_context_stored(void) {
+    /* results of the tests should be written to the table */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2") };
+    struct tric_each each = { .description = "case", .count = 0, .tests = NULL };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    tric_add_test(&context, &tests[0]);
+    tric_add_test(&context, &tests[1]);
+    tric_add_each(&context, &each, 1);
+    tric_store_tests(&suite);
+    context.mode = MODE_RESET;
+
+    tric_reset_context(&context, &tests[1]);
+    assert(context.test == &suite.table[1]);
+
+    context.mode = MODE_RESET;
+    assert(tric_next_case(&context, &each, 0));
+    assert(context.test == &suite.table[2]);
+    assert(context.test->index == 0);
+    free(each.tests);
+    free(suite.table);
+}
+
+
+
+void test_jobs_default(void) {
+    /* tests should run one after another if not specified otherwise */
+
+    assert(tric_jobs(NULL) == 1);
+}
+
+
+
+void test_jobs_number(void) {
+    /* number of jobs should be parsed */
+
+    assert(tric_jobs("1") == 1);
+    assert(tric_jobs("4") == 4);
+    assert(tric_jobs("64") == 64);
+}
+
+
+
+void test_suite_number(void) {
+    /* number of the test suite should be read as number, 0 if not set or invalid */
+
+    assert(tric_suite_number("2") == 2);
+    assert(tric_suite_number("0") == 0);
+    assert(tric_suite_number(NULL) == 0);
+    assert(tric_suite_number("") == 0);
+    assert(tric_suite_number("foo") == 0);
+    assert(tric_suite_number("1x") == 0);
+}
+
+
+
+void test_jobs_limit(void) {
+    /* number of jobs should be limited */
+
+    assert(tric_jobs("1024") == TRIC_JOBS_LIMIT);
+    assert(tric_jobs("100000000") == TRIC_JOBS_LIMIT);
+}
+
+
+
+void test_jobs_auto(void) {
+    /* number of jobs should be the number of processors */
+
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+    assert(tric_jobs("auto") == (processors > 1 ? processors : 1));
+}
+
+
+
+void test_jobs_invalid(void) {
+    /* invalid values should run tests one after another */
+
+    assert(tric_jobs("") == 1);
+    assert(tric_jobs("0") == 1);
+    assert(tric_jobs("-2") == 1);
+    assert(tric_jobs("two") == 1);
+    assert(tric_jobs("2x") == 1);
+}
+
+
+
+void test_batch_default(void) {
+    /* each test should run in a separate process by default */
+
+    struct tric_batch batch = tric_batch(NULL);
+
+    assert(batch.size == 1);
+    assert(batch.adaptive == false);
+}
+
+
+
+void test_batch_number(void) {
+    /* number of tests in the same process should be set */
+
+    struct tric_batch batch = tric_batch("16");
+
+    assert(batch.size == 16);
+    assert(batch.adaptive == false);
 }
 
 
 
-void test_run_before_ok(void) {
-    /* before function should run */
-
-    struct tric_context context = { .mode = MODE_EXECUTE };
-    test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+void test_batch_auto(void) {
+    /* number of tests in the same process should adapt to the execution time */
 
-    tric_run_before(&context, test_before_mock, &context);
+    struct tric_batch batch = tric_batch("auto");
 
-    assert(test_before_mock_data.count == 1);
-    assert(test_before_mock_data.data == &context);
+    assert(batch.size == TRIC_BATCH_LIMIT);
+    assert(batch.adaptive);
 }
 
 
 
-void test_run_before_fail(void) {
-    /* failing before function should exit with failure status */
+void test_batch_invalid(void) {
+    /* invalid values should run each test in a separate process */
 
-    struct tric_context context = { .mode = MODE_EXECUTE };
-    test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
-    test_before_mock_data.result = false;
+    assert(tric_batch("").size == 1);
+    assert(tric_batch("0").size == 1);
+    assert(tric_batch("x").size == 1);
+}
 
-    int status;
-    pid_t child = fork();
-    assert(child != -1);
-    if (child) {
-        waitpid(child, &status, 0);
-    } else {
-        tric_run_before(&context, test_before_mock, NULL);
-        _exit(EXIT_OK);
-    }
 
-    assert(WEXITSTATUS(status) == EXIT_BEFORE_FAILURE);
-}
 
+void test_continue_batch(void) {
+    /* batch should end when it is full or its time is over */
 
+    struct tric_test test = NEW_TEST("test");
+    struct tric_test inline_test = NEW_TEST_WITH("test", .execution = TRIC_EXECUTE_INLINE);
+    struct tric_test repeated_test = NEW_TEST_WITH("test", .repeat = 2);
+    struct tric_test shared_test = NEW_TEST_WITH("test", .share_before = true);
+    struct tric_context context = { .test = &test, .batch = { .size = 2, .length = 1 } };
+    clock_gettime(CLOCK_MONOTONIC, &context.batch.start);
+
+    assert(tric_continue_batch(&context));
+    context.batch.adaptive = true;
+    assert(tric_continue_batch(&context));
+    context.batch.start.tv_sec -= 1;
+    assert(tric_continue_batch(&context) == false);
+    context.batch.adaptive = false;
+    context.test = &inline_test;
+    assert(tric_continue_batch(&context) == false);
+    context.test = &repeated_test;
+    assert(tric_continue_batch(&context) == false);
+    context.test = &shared_test;
+    assert(tric_continue_batch(&context) == false);
+    context.test = &test;
+    context.batch.length = 2;
+    assert(tric_continue_batch(&context) == false);
+}
 
-void test_run_after_null(void) {
-    /* function should exit successfully */
 
-    int status;
-    pid_t child = fork();
-    assert(child != -1);
-    if (child) {
-        waitpid(child, &status, 0);
-    } else {
-        tric_run_after(NULL, NULL);
-        _exit(EXIT_AFTER_FAILURE);
-    }
 
-    assert(WEXITSTATUS(status) == EXIT_OK);
+void test_continue_batch_shared(void) {
+    /* group should only continue with tests sharing the before function */
+
+    struct tric_test test = NEW_TEST("test");
+    struct tric_test shared_test = NEW_TEST_WITH("test", .share_before = true);
+    struct tric_context context = { .test = &shared_test, .number_of_records = 2, .batch = { .length = 1, .shared = true } };
+
+    assert(tric_continue_batch(&context));
+    context.test = &test;
+    assert(tric_continue_batch(&context) == false);
+    context.test = &shared_test;
+    context.batch.length = 2;
+    assert(tric_continue_batch(&context) == false);
 }
 
 
 
-void test_run_after_ok(void) {
-    /* function should exit successfully */
+void test_shares_before(void) {
+    /* group should only be started for forked tests with a before function */
 
-    test_after_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+    struct tric_test test = NEW_TEST("test");
+    struct tric_test shared_test = NEW_TEST_WITH("test", .share_before = true);
+    struct tric_test inline_test = NEW_TEST_WITH("test", .share_before = true, .execution = TRIC_EXECUTE_INLINE);
+    struct tric_context context = { .test = &shared_test, .number_of_records = 2 };
+
+    assert(tric_shares_before(&context, true));
+    assert(tric_shares_before(&context, false) == false);
+    context.test = &test;
+    assert(tric_shares_before(&context, true) == false);
+    context.test = &inline_test;
+    assert(tric_shares_before(&context, true) == false);
+    context.test = &shared_test;
+    context.number_of_records = 1;
+    assert(tric_shares_before(&context, true) == false);
+}
 
-    int status;
-    pid_t child = fork();
-    assert(child != -1);
-    if (child) {
-        waitpid(child, &status, 0);
-    } else {
-        tric_run_after(test_after_mock, NULL);
-        _exit(EXIT_AFTER_FAILURE);
-    }
 
-    assert(WEXITSTATUS(status) == EXIT_OK);
-}
 
+void test_timeout(void) {
+    /* timeout should be read in seconds */
 
+    assert(tric_timeout("2") == 2);
+    assert(tric_timeout("0.5") == 0.5);
+}
 
-void test_run_after_fail(void) {
-    /* function should exit failure status */
 
-    test_after_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
-    test_after_mock_data.result = false;
 
-    int status;
-    pid_t child = fork();
-    assert(child != -1);
-    if (child) {
-        waitpid(child, &status, 0);
-    } else {
-        tric_run_after(test_after_mock, NULL);
-        _exit(EXIT_OK);
-    }
+void test_timeout_invalid(void) {
+    /* tests should have no timeout if not set or invalid */
 
-    assert(WEXITSTATUS(status) == EXIT_AFTER_FAILURE);
+    assert(tric_timeout(NULL) == 0);
+    assert(tric_timeout("") == 0);
+    assert(tric_timeout("0") == 0);
+    assert(tric_timeout("-1") == 0);
+    assert(tric_timeout("1s") == 0);
 }
 
 
 
-void test_skip_test_execution_not(void) {
-    /* status should not be set */
+void test_test_timeout(void) {
+    /* timeout of the test should override the timeout of the test suite */
 
-    struct tric_suite suite = { .skipped_tests = 0 };
-    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED };
-    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite, .test = &test };
+    struct tric_test test = NEW_TEST("test");
+    struct tric_test timed_test = NEW_TEST_WITH("test", .timeout = 2);
+    struct tric_context context = { .test = &test };
+    tric_settings()->timeout = 1;
+
+    assert(tric_test_timeout(&context) == 1);
+    context.test = &timed_test;
+    assert(tric_test_timeout(&context) == 2);
+    tric_settings()->timeout = 0;
+    context.test = &test;
+    assert(tric_test_timeout(&context) == 0);
+}
 
-    tric_skip_test_execution(&context, NULL, NULL);
 
-    assert(suite.skipped_tests == 0);
-    assert(test.before == TRIC_UNDEFINED);
-    assert(test.result == TRIC_UNDEFINED);
-    assert(test.after == TRIC_UNDEFINED);
-    assert(context.mode == MODE_SCAN);
-}
 
+void test_test_runs(void) {
+    /* repeat and retries of the test should override those of the test suite */
 
+    struct tric_test test = NEW_TEST("test");
+    struct tric_test repeated_test = NEW_TEST_WITH("test", .repeat = 3, .retries = 2);
+    struct tric_context context = { .test = &test };
 
-void test_skip_test_execution_ok(void) {
-    /* skipped status should be set and mode should be reset */
+    assert(tric_test_repeat(&context) == 1);
+    assert(tric_test_retries(&context) == 0);
+    assert(tric_has_runs(&context) == false);
+    tric_settings()->retries = 1;
+    assert(tric_test_retries(&context) == 1);
+    assert(tric_has_runs(&context));
+    tric_settings()->retries = 0;
+    context.test = &repeated_test;
+    assert(tric_test_repeat(&context) == 3);
+    assert(tric_test_retries(&context) == 2);
+    assert(tric_has_runs(&context));
+}
 
-    struct tric_suite suite = { .skipped_tests = 0 };
-    struct tric_test test = { .before = TRIC_UNDEFINED, .result = TRIC_UNDEFINED, .after = TRIC_UNDEFINED };
-    struct tric_context context = { .mode = MODE_EXECUTE, .suite = &suite, .test = &test };
-    test_before_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
-    test_after_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
-    tric_log(NULL, test_log_test_mock, NULL, &context);
-    test_log_test_mock_data = (struct test_logger_mock_data)TEST_LOGGER_MOCK_DATA_NEW;
 
-    tric_skip_test_execution(&context, test_before_mock, test_after_mock);
 
-    assert(suite.skipped_tests == 1);
-    assert(test.before == TRIC_SKIPPED);
-    assert(test.result == TRIC_SKIPPED);
-    assert(test.after == TRIC_SKIPPED);
-    assert(test_before_mock_data.count == 0);
-    assert(test_after_mock_data.count == 0);
-    assert(test_log_test_mock_data.count == 1);
-    assert(test_log_test_mock_data.suite == &suite);
-    assert(test_log_test_mock_data.test == &test);
-    assert(test_log_test_mock_data.data == &context);
-    assert(context.mode == MODE_RESET);
-}
+void test_retries(void) {
+    /* retries should be read as number, 0 if not set or invalid */
 
+    assert(tric_retries("3") == 3);
+    assert(tric_retries("0") == 0);
+    assert(tric_retries(NULL) == 0);
+    assert(tric_retries("") == 0);
+    assert(tric_retries("-1") == 0);
+    assert(tric_retries("1x") == 0);
+}
 
 
-void test_reporting_all(void) {
-    /* all logging functions should be set */
 
-    /* ensure default configuration */
-    tric_reporting(true, tric_log_start, tric_log_test, tric_log_end, NULL);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == tric_log_start);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == tric_log_test);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == tric_log_end);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == NULL);
+void test_remaining_time(void) {
+    /* remaining time of test should be calculated from its start */
 
-    void *test_reference = NULL;
-    tric_reporting(true, test_log_start_mock, test_log_test_mock, test_log_end_mock, &test_reference);
+    struct tric_record record = { .timeout = 0 };
 
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == test_log_start_mock);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == test_log_test_mock);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == test_log_end_mock);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == &test_reference);
+    assert(tric_remaining_time(&record) == -1);
+    record.timeout = 10;
+    assert(tric_remaining_time(&record) == 10);
+    clock_gettime(CLOCK_MONOTONIC, &record.start);
+    assert(tric_remaining_time(&record) > 9);
+    assert(tric_remaining_time(&record) <= 10);
+    record.start.tv_sec -= 20;
+    assert(tric_remaining_time(&record) == 0);
 }
 
 
 
-void test_reporting_none(void) {
-    /* logging functions should be set to no logger */
+void test_exceeded(void) {
+    /* signals should only count as exceeded limit if the limit is set */
 
-    /* ensure default configuration */
-    tric_reporting(true, tric_log_start, tric_log_test, tric_log_end, NULL);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == tric_log_start);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == tric_log_test);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == tric_log_end);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == NULL);
+    struct tric_test test = NEW_TEST("test");
+    struct tric_test limited_test = NEW_TEST_WITH("test", .memory_limit = 1, .cpu_limit = 1, .output_limit = 1);
+
+    assert(tric_exceeded(&test, SIGXCPU) == false);
+    assert(tric_exceeded(&test, SIGKILL) == false);
+    assert(tric_exceeded(&limited_test, SIGXCPU));
+    assert(tric_exceeded(&limited_test, SIGXFSZ));
+    assert(tric_exceeded(&limited_test, SIGKILL));
+    assert(tric_exceeded(&limited_test, SIGABRT));
+    assert(tric_exceeded(&limited_test, SIGSEGV) == false);
+}
 
-    tric_reporting(true, NULL, NULL, NULL, NULL);
 
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == tric_log_nothing);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == tric_log_nothing);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == tric_log_nothing);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == NULL);
+
+void test_exit_status(void) {
+    /* exit status of test should be determined from status of its process */
+
+    struct tric_test test = NEW_TEST_WITH("test", .cpu_limit = 1);
+    int status;
+    pid_t child = fork();
+    assert(child != -1);
+    if (child == 0) {
+        raise(SIGXCPU);
+        _exit(EXIT_OK);
+    }
+    waitpid(child, &status, 0);
+
+    assert(tric_exit_status(&test, status, false) == EXIT_EXCEEDED);
+    assert(tric_exit_status(&test, status, true) == EXIT_TIMEOUT);
+    test.options.cpu_limit = 0;
+    assert(tric_exit_status(&test, status, false) == EXIT_SIGNAL);
 }
 
 
 
-void test_report(void) {
-    /* logger functions should be accessible */
+void test_has_limits(void) {
+    /* any resource limit should be found */
 
-    /* ensure default configuration */
-    tric_reporting(true, tric_log_start, tric_log_test, tric_log_end, NULL);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == tric_log_start);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == tric_log_test);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == tric_log_end);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == NULL);
+    struct tric_test test = NEW_TEST("test");
+    struct tric_test limited_test = NEW_TEST_WITH("test", .output_limit = 1);
 
-    struct tric_reporting_data *result = tric_report();
+    assert(tric_has_limits(&test) == false);
+    assert(tric_has_limits(&limited_test));
+}
 
-    assert(result->start == tric_log_start);
-    assert(result->test == tric_log_test);
-    assert(result->end == tric_log_end);
-    assert(result->data == NULL);
+
+
+void test_create_queue_sequential(void) {
+    /* no queue should be created for a single job */
+
+    struct tric_queue queue = { .jobs = 1 };
+
+    assert(tric_create_queue(&queue, 10) == NULL);
 }
 
 
 
-void test_log(void) {
-    /* all logger functions should be set */
+void test_create_queue_parallel(void) {
+    /* queue should hold all tests of the suite */
 
-    /* ensure default configuration */
-    tric_reporting(true, tric_log_start, tric_log_test, tric_log_end, NULL);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == tric_log_start);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == tric_log_test);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == tric_log_end);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == NULL);
+    struct tric_queue queue = { .jobs = 2, .running = 1, .head = 1, .length = 1 };
 
-    void *test_reference = NULL;
-    tric_log(test_log_start_mock, test_log_test_mock, test_log_end_mock, &test_reference);
+    assert(tric_create_queue(&queue, 10) == &queue);
+    assert(queue.capacity == 10);
+    assert(queue.running == 0);
+    assert(queue.head == 0);
+    assert(queue.length == 0);
+    assert(queue.entries != NULL);
 
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->start == test_log_start_mock);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->test == test_log_test_mock);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->end == test_log_end_mock);
-    assert(tric_reporting(false, NULL, NULL, NULL, NULL)->data == &test_reference);
+    free(queue.entries);
+    queue.jobs = 4;
+
+    assert(tric_create_queue(&queue, 1) == &queue);
+    assert(queue.capacity == 4);
+
+    free(queue.entries);
 }
 
 
 
-void test_run_fixture_not(void) {
-    // no fixture to execute should be ok */
+void test_create_schedule_none(void) {
+    /* tests should be started when they are reached without parallel jobs or durations */
 
-    bool result = tric_run_fixture(NULL, NULL);
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2") };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    tric_add_test(&context, &tests[0]);
+    tric_add_test(&context, &tests[1]);
+    tric_store_tests(&suite);
 
-    assert(result == true);
+    assert(tric_create_schedule(&suite, 4) == NULL);
+    suite.table[0].previous_duration = 1;
+    assert(tric_create_schedule(&suite, 1) == NULL);
+
+    free(suite.table);
 }
 
 
 
-void test_run_fixture_ok(void) {
-    /* successfully run fixture should return true */
+void test_create_schedule_durations(void) {
+    /* longest tests should be ranked first, tests without duration last */
 
-    test_setup_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3"), NEW_TEST("4"), NEW_TEST("5"), NEW_TEST("6") };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    size_t i;
+    for (i = 0; i < 6; i++) {
+        tric_add_test(&context, &tests[i]);
+    }
+    tric_store_tests(&suite);
+    suite.table[0].previous_duration = 1;
+    suite.table[1].previous_duration = 5;
+    suite.table[2].previous_duration = 2;
+    suite.table[4].previous_duration = 9;
+    suite.table[5].previous_duration = 3;
+
+    size_t *ranks = tric_create_schedule(&suite, 2);
+
+    assert(ranks != NULL);
+    assert(ranks[4] == 0);
+    assert(ranks[1] == 1);
+    assert(ranks[5] == 2);
+    assert(ranks[2] == 3);
+    assert(ranks[0] == 4);
+    assert(ranks[3] == 5);
+
+    free(ranks);
+    free(suite.table);
+}
 
-    void *test_reference = NULL;
-    bool result = tric_run_fixture(test_setup_mock, &test_reference);
 
-    assert(result == true);
-    assert(test_setup_mock_data.count == 1);
-    assert(test_setup_mock_data.data == &test_reference);
+
+void test_create_schedule_failed_first(void) {
+    /* tests that failed before should be ranked first, also without parallel jobs */
+
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2"), NEW_TEST("3") };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    size_t i;
+    for (i = 0; i < 3; i++) {
+        tric_add_test(&context, &tests[i]);
+    }
+    tric_store_tests(&suite);
+    suite.table[0].previous_result = TRIC_OK;
+    suite.table[1].previous_result = TRIC_TIMEOUT;
+
+    assert(tric_create_schedule(&suite, 1) == NULL);
+    tric_settings()->failed_first = true;
+    size_t *ranks = tric_create_schedule(&suite, 1);
+    tric_settings()->failed_first = false;
+
+    assert(ranks != NULL);
+    assert(ranks[1] == 0);
+    assert(ranks[0] == 1);
+    assert(ranks[2] == 2);
+
+    free(ranks);
+    free(suite.table);
 }
 
 
 
-void test_run_fixture_fail(void) {
-    /* failing fixture should return false */
+void test_sum_cpu_time(void) {
+    /* CPU time of all tests should be added up */
 
-    test_setup_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
-    test_setup_mock_data.result = false;
+    struct tric_suite suite = NEW_SUITE("test suite");
+    struct tric_test tests[] = { NEW_TEST("1"), NEW_TEST("2") };
+    struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
+    tric_add_test(&context, &tests[0]);
+    tric_add_test(&context, &tests[1]);
+    tests[0].user_time = 1.5;
+    tests[0].system_time = 0.5;
+    tests[1].user_time = 2;
 
-    void *test_reference = NULL;
-    bool result = tric_run_fixture(test_setup_mock, &test_reference);
+    tric_sum_cpu_time(&suite);
 
-    assert(result == false);
-    assert(test_setup_mock_data.count == 1);
-    assert(test_setup_mock_data.data == &test_reference);
+    assert(suite.cpu_time == 4);
 }
 
 
 
-void test_scan_tests(void) {
-    /* suite function should execute scan */
+void test_create_queue_ordered(void) {
+    /* queue should be created for a single job to start the tests in the order of their ranks */
 
-    struct tric_suite suite;
-    struct tric_test test;
-    struct tric_context context = { .mode = MODE_RESET, .suite = &suite, .test = &test };
-    test_suite_mock_data = (struct test_suite_mock_data)TEST_SUITE_MOCK_DATA_NEW;
+    size_t ranks[10] = { 0 };
+    struct tric_queue queue = { .jobs = 1, .ranks = ranks };
 
-    tric_scan_tests(&context);
+    assert(tric_create_queue(&queue, 10) == &queue);
+    assert(queue.held == 0);
+    assert(queue.capacity == 10);
 
-    assert(test_suite_mock_data.count == 1);
-    assert(test_suite_mock_data.context_mode == MODE_SCAN);
-    assert(test_suite_mock_data.context_suite == &suite);
-    assert(test_suite_mock_data.context_reference == &context);
-    assert(context.mode == MODE_RESET);
-    assert(context.test == NULL);
+    free(queue.entries);
 }
 
 
@@ -1811,7 +4519,7 @@ void test_run_tests_fail_setup(void) {
 void test_run_tests_ok(void) {
     /* setup, reporting and teardown should be called */
 
-    struct tric_suite suite;
+    struct tric_suite suite = NEW_SUITE("test suite");
     struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
     test_suite_mock_data = (struct test_suite_mock_data)TEST_SUITE_MOCK_DATA_NEW;
     test_setup_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
@@ -1847,7 +4555,7 @@ void test_run_tests_ok(void) {
 void test_run_tests_fail_teardown(void) {
     /* failing teardown should return failure */
 
-    struct tric_suite suite;
+    struct tric_suite suite = NEW_SUITE("test suite");
     struct tric_context context = { .mode = MODE_SCAN, .suite = &suite };
     test_suite_mock_data = (struct test_suite_mock_data)TEST_SUITE_MOCK_DATA_NEW;
     test_setup_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
@@ -1881,14 +4589,39 @@ void test_run_tests_fail_teardown(void) {
 
 
 
-void test_main_fail_open(void) {
-    /* failing to open itself should return error */
+void test_main_no_path(void) {
+    /* name of executable should not be needed */
 
-    char *arguments[] = { "/dev/null/no/file" };
+    char *arguments[] = { "no/path/to/test" };
+    test_suite_mock_data = (struct test_suite_mock_data)TEST_SUITE_MOCK_DATA_NEW;
+    test_setup_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+    test_teardown_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
 
     int result = tric_main(1, arguments);
 
-    assert(result == EX_NOINPUT);
+    assert(result == EX_OK);
+    assert(test_suite_mock_data.count == 2);
+}
+
+
+
+void test_main_invalid_shard(void) {
+    /* invalid shard index should be rejected without executing the test suite */
+
+    char *arguments[] = { "test" };
+    test_suite_mock_data = (struct test_suite_mock_data)TEST_SUITE_MOCK_DATA_NEW;
+    setenv(TRIC_SHARD_COUNT, "2", 1);
+    setenv(TRIC_SHARD_INDEX, "2", 1);
+
+    assert(tric_main(1, arguments) == EX_USAGE);
+    setenv(TRIC_SHARD_INDEX, "x", 1);
+    assert(tric_main(1, arguments) == EX_USAGE);
+    assert(test_suite_mock_data.count == 0);
+
+    unsetenv(TRIC_SHARD_COUNT);
+    unsetenv(TRIC_SHARD_INDEX);
+    tric_settings()->shard_count = 1;
+    tric_settings()->shard_index = 0;
 }
 
 
@@ -1910,6 +4643,23 @@ test_setup_mock_data.result = false;
 
 
 
+void test_run_spawned_not_started(void) {
+    /* spawned process should report that it could not start a missing test or a test whose setup failed */
+
+    test_suite_mock_data = (struct test_suite_mock_data)TEST_SUITE_MOCK_DATA_NEW;
+    test_setup_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+
+    assert(tric_run_spawned("5") == EXIT_NOT_STARTED);
+    assert(test_suite_mock_data.count == 2);
+    test_setup_mock_data.result = false;
+    assert(tric_run_spawned("5") == EXIT_NOT_STARTED);
+    assert(test_suite_mock_data.count == 3);
+    assert(tric_run_spawned("0") == EX_USAGE);
+    test_setup_mock_data = (struct test_fixture_mock_data)TEST_FIXTURE_MOCK_DATA_NEW;
+}
+
+
+
 void test_main_fail_teardown(int argc, char *argv[]) {
     /* failing teardown should return error */
 
@@ -1952,6 +4702,9 @@ int main(int argc, char *argv[]) {
     /* turn off default logging */
     tric_log(NULL, NULL, NULL, NULL);
 
+    test_records = tric_map_records(TEST_RECORDS_SIZE, -1);
+    assert(test_records != NULL);
+
     test_new_suite();
 
     test_suite_data();
@@ -1975,29 +4728,48 @@ int main(int argc, char *argv[]) {
     test_skip_test_fail_after();
     test_skip_test_no_fixtures();
 
-    test_assert_fail(argv[0]);
-    test_assert_pass(argv[0]);
+    test_assert_fail();
+    test_assert_pass();
 
     test_fixture_scan();
     test_fixture_execute();
     test_fixture_reset();
+    test_fixture_parallel();
+    test_fixture_spawn();
+    test_fixture_spawn_override();
 
     test_add_test_not();
     test_add_test_first();
     test_add_test_second();
 
     test_reset_context_not();
-    test_reset_context_run(argv[0]);
+    test_reset_context_run();
+    test_add_each();
+    test_add_each_not();
+    test_next_case();
+    test_each_macro();
+    test_each_line();
+    test_test_execution_each();
+
+    test_create_records_file();
+    test_map_records();
+    test_unused_record();
+    test_reset_record();
+    test_read_record();
+    test_read_record_crash();
+    test_read_record_backtrace();
+    test_read_record_spawned();
+    test_read_usage();
 
     test_status_ok_all();
     test_status_ok_none();
     test_status_ok_before();
     test_status_ok_after();
 
-    test_status_fail_all(argv[0]);
-    test_status_fail_none(argv[0]);
-    test_status_fail_before(argv[0]);
-    test_status_fail_after(argv[0]);
+    test_status_fail_all();
+    test_status_fail_none();
+    test_status_fail_before();
+    test_status_fail_after();
 
     test_status_fail_before_all();
     test_status_fail_before_none();
@@ -2013,6 +4785,8 @@ int main(int argc, char *argv[]) {
     test_status_crash_none();
     test_status_crash_before();
     test_status_crash_after();
+    test_status_timeout();
+    test_status_exceeded();
 
     test_status_fail_fork_all();
     test_status_fail_fork_none();
@@ -2025,28 +4799,87 @@ int main(int argc, char *argv[]) {
     test_status_skip_after();
 
     test_set_status_ok();
-    test_set_status_test_failure(argv[0]);
+    test_set_status_test_failure();
     test_set_status_before_failure();
     test_set_status_after_failure();
     test_set_status_signal();
     test_set_status_fork();
+    test_set_status_timeout();
+    test_set_status_exceeded();
+    test_set_status_not_started();
     test_set_status_skip();
 
     test_run_test_not();
     test_run_test_ok();
     test_run_test_signal();
+    test_run_test_timeout();
+    test_run_test_stragglers();
+    test_run_test_limits();
+    test_run_test_core_dump();
+    test_run_test_crash_backtrace();
+    test_run_test_spawned();
+    test_run_test_retries();
+    test_run_test_repeat();
+    test_run_test_shared_before();
+    test_run_test_inline_after_shared_before();
+    test_run_before_shared_other();
+    test_run_test_parallel();
+    test_run_test_inline();
+    test_run_test_inline_fail();
+    test_run_test_inline_signal();
+    test_run_test_batch();
 
     test_run_before_not();
     test_run_before_null();
     test_run_before_ok();
     test_run_before_fail();
+    test_run_before_inline();
 
     test_run_after_null();
     test_run_after_ok();
     test_run_after_fail();
 
+    test_selected_id();
+    test_is_selected();
+    test_has_tag();
+    test_selected_tags();
+    test_is_selected_tags();
+    test_failed_result();
+    test_is_selected_rerun_failed();
+    test_tagged_test();
+    test_run_test_not_selected();
+    test_status_not_in_shard();
+    test_status_not_run();
+    test_status_deferred();
+    test_in_shard();
+    test_shard_index();
+    test_assign_shards_id();
+    test_assign_shards_duration();
+    test_result_name();
+    test_history();
+    test_history_deferred();
+    test_history_shards();
+    test_history_missing();
+    test_run_test_not_in_shard();
+    test_stopped();
+    test_run_test_stopped();
+    test_run_test_parallel_failure();
+    test_run_test_parallel_stopped();
+    test_run_test_held();
+    test_run_test_held_fixture();
+    test_run_test_held_sequential();
+    test_max_failures();
+    test_time_budget();
+    test_defer_tests();
+    test_defer_tests_none();
+    test_defer_tests_over_budget();
+    test_deferred();
+    test_run_test_deferred();
     test_skip_test_execution_not();
+    test_skip_test_execution_not_in_shard();
+    test_skip_test_execution_spawned();
     test_skip_test_execution_ok();
+    test_skip_test_execution_parallel();
 
     test_reporting_all();
     test_reporting_none();
@@ -2061,15 +4894,62 @@ int main(int argc, char *argv[]) {
 
     test_scan_tests();
 
+    test_register_tests();
+    test_register_tests_empty();
+    test_register_tests_each();
+    test_find_tests();
+    test_store_tests();
+    test_store_tests_empty();
+    test_free_tests();
+    test_suite_test();
+    test_reset_context_stored();
+
+    test_jobs_default();
+    test_jobs_number();
+    test_jobs_limit();
+    test_suite_number();
+    test_jobs_auto();
+    test_jobs_invalid();
+    test_timeout();
+    test_timeout_invalid();
+    test_test_timeout();
+    test_test_runs();
+    test_retries();
+    test_remaining_time();
+    test_reap_group();
+    test_has_children();
+    test_exceeded();
+    test_exit_status();
+    test_has_limits();
+    test_batch_default();
+    test_batch_number();
+    test_batch_auto();
+    test_batch_invalid();
+    test_continue_batch();
+    test_continue_batch_shared();
+    test_shares_before();
+
+    test_create_queue_sequential();
+    test_create_queue_parallel();
+    test_create_queue_ordered();
+    test_create_schedule_none();
+    test_create_schedule_durations();
+    test_create_schedule_failed_first();
+    test_sum_cpu_time();
+
     test_run_tests_fail_setup();
     test_run_tests_ok();
     test_run_tests_fail_teardown();
 
-    test_main_fail_open();
+    test_main_no_path();
+    test_main_invalid_shard();
     test_main_fail_setup(argc, argv);
+    test_run_spawned_not_started();
     test_main_fail_teardown(argc, argv);
     test_main_ok(argc, argv);
 
+    tric_unmap_records(test_records, TEST_RECORDS_SIZE);
+
     return 0;
 }
 
@@ -0,0 +1,25 @@
+/*
+TRIC - Minimalistic unit testing framework for c
+Functions of TRIC built once into a library
+Copyright 2024 Philip Colombo
+
+This file is part of TRIC.
+
+TRIC is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+TRIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with TRIC.  If not, see <https://www.gnu.org/licenses/>.
+
+*/
+
+
+
+/*
+Build this file into a library and compile the test suites with TRIC_LIBRARY defined to link them against the library instead of compiling the functions of TRIC into each test suite. Compiled with TRIC_MULTIPLE_SUITES defined, the library contains the runner of several test suites linked into one executable.
+*/
+
+#define TRIC_RUNNER
+#include "tric.h"
+#include "tric_assert.h"
+#include "tric_output.h"
@@ -22,9 +22,28 @@ You should have received a copy of the GNU Lesser General Public License along w
 #include <unistd.h>
 #include <sysexits.h>
 #include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <poll.h>
+#include <spawn.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
 #include <fcntl.h>
+#include <fnmatch.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#ifdef __GLIBC__
+#include <execinfo.h>
+#endif
 
 
 
@@ -64,6 +83,197 @@ test 1 of 1 ("simple failing test") failed at line 5
 
 
 
+/*
+internally used
+environment variable to set the number of tests executed in parallel
+*/
+#define TRIC_JOBS "TRIC_JOBS"
+
+
+
+/*
+internally used
+maximum number of tests executed in parallel, the processes of the running tests are watched with an array on the stack
+*/
+#define TRIC_JOBS_LIMIT 1024
+
+
+
+/*
+internally used
+number of additional records for forked tests waiting to be started in the order of the history
+*/
+#define TRIC_HELD_LIMIT 64
+
+
+
+/*
+internally used
+environment variable to set the number of tests executed one after another in the same process
+*/
+#define TRIC_BATCH "TRIC_BATCH"
+
+
+
+/*
+internally used
+maximum number of tests and time in seconds after which no further test is started in the same process if the number of tests is adapted to the execution time
+*/
+#define TRIC_BATCH_LIMIT 64
+#define TRIC_BATCH_TIME 0.01
+
+
+
+/*
+internally used
+environment variables to set the timeout of the tests in seconds and to print a backtrace of tests that timed out
+*/
+#define TRIC_TEST_TIMEOUT "TRIC_TEST_TIMEOUT"
+#define TRIC_BACKTRACE "TRIC_BACKTRACE"
+
+
+
+/*
+internally used
+signal sent to a test that timed out to print a backtrace, time in seconds to wait for the backtrace
+and time in seconds between checks of the tests if waiting for processes with poll is not supported
+*/
+#define TRIC_BACKTRACE_SIGNAL SIGQUIT
+#define TRIC_BACKTRACE_TIME 0.1
+#define TRIC_POLL_TIME 0.001
+
+
+
+/*
+internally used
+environment variable to allow core dumps of crashing tests
+*/
+#define TRIC_CORE_DUMP "TRIC_CORE_DUMP"
+
+
+
+/*
+internally used
+environment variables to spawn a new process of the test suite for each test and to execute a single test in the process of the test suite
+executable started for the tests
+*/
+#define TRIC_SPAWN "TRIC_SPAWN"
+#define TRIC_TEST_ID "TRIC_TEST_ID"
+#define TRIC_SPAWN_PATH "/proc/self/exe"
+
+
+
+/*
+internally used
+environment variables to set how often each test is executed and how often a failing test is executed again
+*/
+#define TRIC_REPEAT "TRIC_REPEAT"
+#define TRIC_RETRIES "TRIC_RETRIES"
+
+
+
+/*
+internally used
+environment variable to execute only the test suite with the given number if several test suites are linked into one runner
+*/
+#define TRIC_SUITE "TRIC_SUITE"
+
+
+
+/*
+internally used
+environment variables to select the tests executed by a pattern matching their description and by a list of their IDs
+*/
+#define TRIC_FILTER "TRIC_FILTER"
+#define TRIC_TESTS "TRIC_TESTS"
+
+
+
+/*
+internally used
+environment variable to select the tests executed by their tags
+*/
+#define TRIC_TAGS "TRIC_TAGS"
+
+
+
+/*
+internally used
+environment variables to execute only the tests of one of several shards of the test suite
+*/
+#define TRIC_SHARD_COUNT "TRIC_SHARD_COUNT"
+#define TRIC_SHARD_INDEX "TRIC_SHARD_INDEX"
+
+
+
+/*
+internally used
+environment variable to set the file with the results and durations of the tests of previous runs
+*/
+#define TRIC_HISTORY "TRIC_HISTORY"
+
+
+
+/*
+internally used
+environment variables to start the tests that failed in the previous run first or to execute only these tests
+*/
+#define TRIC_FAILED_FIRST "TRIC_FAILED_FIRST"
+#define TRIC_RERUN_FAILED "TRIC_RERUN_FAILED"
+
+
+
+/*
+internally used
+environment variable to stop the test suite after the given number of failed tests
+*/
+#define TRIC_MAX_FAILURES "TRIC_MAX_FAILURES"
+
+
+
+/*
+internally used
+environment variable to set the time available to execute the test suite, e.g. "120s" or "2m"
+*/
+#define TRIC_TIME_BUDGET "TRIC_TIME_BUDGET"
+
+
+
+/**
+ * \brief Maximum number of frames recorded in the backtrace of a crashed test.
+ */
+#ifndef TRIC_BACKTRACE_FRAMES
+#define TRIC_BACKTRACE_FRAMES 16
+#endif
+
+
+
+/*
+internally used
+register tests in a linker section so they are found without scanning the test suite
+*/
+#if defined(__ELF__) && defined(__GNUC__) && !defined(TRIC_NO_SECTIONS) && !defined(TRIC_MULTIPLE_SUITES)
+#define TRIC_SECTIONS
+#endif
+
+
+
+/*
+internally used
+several test suites linked into one runner register themselves in a linker section, their tests are found by scanning the test suites
+the functions of TRIC are only defined in the file of the runner, or in tric.c if TRIC is used as a library
+*/
+#ifdef TRIC_MULTIPLE_SUITES
+#if !defined(__ELF__) || !defined(__GNUC__)
+#error "TRIC_MULTIPLE_SUITES requires linker sections (ELF and GCC compatible compiler)"
+#endif
+#endif
+#if (!defined(TRIC_MULTIPLE_SUITES) && !defined(TRIC_LIBRARY)) || defined(TRIC_RUNNER)
+#define TRIC_DEFINITIONS
+#endif
+
+
+
 /*
  internally used
 create unique name for per test data
@@ -73,6 +283,18 @@ create unique name for per test data
 
 
 
+/*
+internally used
+number increasing with each test in the file, so several tests can be defined in the same line
+*/
+#ifdef __COUNTER__
+#define TRIC_COUNTER __COUNTER__
+#else
+#define TRIC_COUNTER __LINE__
+#endif
+
+
+
 /*
 internally used
 default initialization of suite data
@@ -84,7 +306,13 @@ default initialization of suite data
     .executed_tests = 0, \
     .failed_tests = 0, \
     .skipped_tests = 0, \
-    .tests = NULL \
+    .not_in_shard_tests = 0, \
+    .not_run_tests = 0, \
+    .deferred_tests = 0, \
+    .duration = 0, \
+    .cpu_time = 0, \
+    .tests = NULL, \
+    .table = NULL \
 }
 
 
@@ -102,19 +330,41 @@ const struct tric_suite_data *tric_data(void) { \
 
 
 
+/*
+internally used
+create data of a test suite linked into a runner together with other test suites and register it in the linker section of the test suites
+*/
+#define SUITE_ENTRY(DESCRIPTION, SETUP, TEARDOWN, DATA) \
+static void tric_file_suite_function(struct tric_context *tric_context); \
+static struct tric_suite tric_file_suite = NEW_SUITE(DESCRIPTION); \
+static const struct tric_suite_data tric_file_suite_data = { .suite = &tric_file_suite, .setup = SETUP, .teardown = TEARDOWN, .data = DATA }; \
+static const struct tric_suite_entry tric_file_suite_entry __attribute__((section("tric_suites"), used)) = { .data = &tric_file_suite_data, .function = tric_file_suite_function };
+
+
+
 /**
  * \brief Create the test suite.
  *
  * There must be exactly one test suite in a file and all tests must be inside the test suite. The description should not be omitted. All other arguments can be omitted by setting them to NULL.
  *
+ * If TRIC_MULTIPLE_SUITES is defined, the test suites of several files can be linked into one executable. Then exactly one of the files must define TRIC_RUNNER before including tric.h. This file contains the functions of TRIC and the main function, which executes the test suites one after another.
+ *
+ * If TRIC_LIBRARY is defined, tric.h only declares the functions of TRIC. The functions and the main function are then linked from the library built from tric.c.
+ *
  * \param DESCRIPTION String literal to describe the test suite.
  * \param SETUP Function of type tric_fixture_t that will be executed before the tests will be run. May be NULL.
  * \param TEARDOWN Function of type tric_fixture_t that will be executed after all tests have been run. May be NULL.
  * \param DATA Pointer to user data that is passed to the setup and teardown functions. The pointer must reference data that is compile constant (e.g. static data) or there will be a compilation error.
  */
+#ifdef TRIC_MULTIPLE_SUITES
+#define SUITE(DESCRIPTION, SETUP, TEARDOWN, DATA) \
+SUITE_ENTRY(DESCRIPTION, SETUP, TEARDOWN, DATA) \
+static void tric_file_suite_function(struct tric_context *tric_context)
+#else
 #define SUITE(DESCRIPTION, SETUP, TEARDOWN, DATA) \
 SUITE_DATA(DESCRIPTION, SETUP, TEARDOWN, DATA) \
 void tric_suite_function(struct tric_context *tric_context)
+#endif
 
 
 
@@ -123,6 +373,15 @@ internally used
 default initialization of test data
 */
 #define NEW_TEST(DESCRIPTION) \
+NEW_TEST_WITH(DESCRIPTION, .execution = TRIC_EXECUTE_DEFAULT)
+
+
+
+/*
+internally used
+initialization of test data with options
+*/
+#define NEW_TEST_WITH(DESCRIPTION, ...) \
 { \
     .id = 0, \
     .description = DESCRIPTION, \
@@ -131,19 +390,92 @@ default initialization of test data
     .after = TRIC_UNDEFINED, \
     .line = 0, \
     .signal = 0, \
+    .file = NULL, \
+    .assertions = 0, \
+    .duration = 0, \
+    .user_time = 0, \
+    .system_time = 0, \
+    .max_rss = 0, \
+    .minor_faults = 0, \
+    .major_faults = 0, \
+    .voluntary_switches = 0, \
+    .involuntary_switches = 0, \
+    .stragglers = 0, \
+    .frames = 0, \
+    .runs = 0, \
+    .failed_runs = 0, \
+    .index = 0, \
+    .cases = 0, \
+    .shard = 0, \
+    .deferred = false, \
+    .over_budget = false, \
+    .previous_result = TRIC_UNDEFINED, \
+    .previous_duration = -1, \
+    .options = { __VA_ARGS__ }, \
     .next = NULL \
 }
 
 
 
+/*
+internally used
+add test data to the linker section of the tests
+*/
+#ifdef TRIC_SECTIONS
+#define REGISTER_TEST(TEST, ID) \
+    static struct tric_entry UNIQUE_NAME(tric_entry, ID) __attribute__((section("tric_tests"), used)) = { .test = &(TEST), .order = ID };
+#else
+#define REGISTER_TEST(TEST, ID)
+#endif
+
+
+
 /*
 internally used
 create test data and prepare for test execution
 */
 #define PREPARE_TEST(DESCRIPTION) \
-    static struct tric_test UNIQUE_NAME(tric_test, __LINE__) = NEW_TEST(DESCRIPTION); \
-    tric_add_test(tric_context, &(UNIQUE_NAME(tric_test, __LINE__))); \
-    tric_reset_context(tric_context, &(UNIQUE_NAME(tric_test, __LINE__)));
+PREPARE_TEST_WITH(DESCRIPTION, .execution = TRIC_EXECUTE_DEFAULT)
+
+
+
+/*
+internally used
+create test data with options and prepare for test execution
+*/
+#define PREPARE_TEST_WITH(DESCRIPTION, ...) \
+    PREPARE_TEST_ID(TRIC_COUNTER, DESCRIPTION, __VA_ARGS__)
+
+
+
+/*
+internally used
+create test data with a unique ID in the file and prepare for test execution
+*/
+#define PREPARE_TEST_ID(ID, DESCRIPTION, ...) \
+    static struct tric_test UNIQUE_NAME(tric_test, ID) = NEW_TEST_WITH(DESCRIPTION, __VA_ARGS__); \
+    REGISTER_TEST(UNIQUE_NAME(tric_test, ID), ID) \
+    tric_add_test(tric_context, &(UNIQUE_NAME(tric_test, ID))); \
+    tric_reset_context(tric_context, &(UNIQUE_NAME(tric_test, ID)));
+
+
+
+/*
+internally used
+execute test and its fixtures
+a test executed in the process of the test suite jumps back to sigsetjmp when it is terminated
+*/
+#define EXECUTE_TEST(BEFORE, AFTER, DATA) \
+    if (tric_run_test(tric_context, (BEFORE) ? true : false, (AFTER) ? true : false)) { \
+        if (sigsetjmp(tric_context->inline_test.jump, 1) != 0) { \
+            tric_resume_inline(tric_context); \
+        } \
+    } \
+    for ( \
+        tric_run_before(tric_context, (BEFORE), (DATA)); \
+        (tric_context->mode == MODE_EXECUTE) && ((tric_context->mode = MODE_RESET) == MODE_RESET); \
+        tric_run_after(tric_context, (AFTER), (DATA)) \
+    )
 
 
 
@@ -159,111 +491,253 @@ create test data and prepare for test execution
  */
 #define TEST(DESCRIPTION, BEFORE, AFTER, DATA) \
     PREPARE_TEST(DESCRIPTION) \
-    tric_run_test(tric_context, (BEFORE) ? true : false, (AFTER) ? true : false); \
-    for ( \
-        tric_run_before(tric_context, (BEFORE), (DATA)); \
-        (tric_context->mode == MODE_EXECUTE) && ((tric_context->mode = MODE_RESET) == MODE_RESET); \
-        tric_run_after((AFTER), (DATA)) \
-    )
+    EXECUTE_TEST(BEFORE, AFTER, DATA)
 
 
 
 /**
- * \brief Create a test that is skipped.
+ * \brief Create a test with options.
  *
- * The description of the test should not be omitted. All other arguments can be omitted by setting them to NULL. The code of the test as well as the BEFORE and AFTER functions are not executed and the test is marked as skipped.
+ * The TEST_WITH macro works like the TEST macro. Additionally the options of the test (see struct tric_options) can be passed as designated initializers after the DATA argument, e.g. .execution = TRIC_EXECUTE_INLINE. Options that are not passed keep their default values.
  *
  * \param DESCRIPTION String literal to describe the test.
- * \param BEFORE Function of type tric_fixture_t that would be executed before the test would be run. May be NULL.
- * \param AFTER Function of type tric_fixture_t that would be executed after the test would be run. May be NULL.
- * \param DATA User data that would be passed to the before and after functions.
+ * \param BEFORE Function of type tric_fixture_t that will be executed before the test is run. May be NULL.
+ * \param AFTER Function of type tric_fixture_t that will be executed after the test is run. May be NULL.
+ * \param DATA User data that is passed to the before and after functions.
+ * \param ... Designated initializers of struct tric_options.
  */
-#define SKIP_TEST(DESCRIPTION, BEFORE, AFTER, DATA) \
-    PREPARE_TEST(DESCRIPTION) \
-    tric_skip_test_execution(tric_context, (BEFORE), (AFTER)); \
-    if (false)
+#define TEST_WITH(DESCRIPTION, BEFORE, AFTER, DATA, ...) \
+    PREPARE_TEST_WITH(DESCRIPTION, __VA_ARGS__) \
+    EXECUTE_TEST(BEFORE, AFTER, DATA)
 
 
 
 /**
- * \brief Verify an expression.
+ * \brief Create a test that is executed in the process of the test suite.
  *
- * The given expression is executed and if it is false, the test is terminated and marked as failed. If the expression is true, nothing happens and the execution of the test continues.
- *
- * there can be any number of ASSERTs per test. Since ASSERT terminates the calling process, it should not be used outside of a test.
+ * The INLINE_TEST macro works like the TEST macro, but the test as well as the BEFORE and AFTER functions are executed without forking a separate process. A failing ASSERT jumps back to the test suite and a test crashing due to SIGSEGV, SIGFPE or SIGBUS is reported as crashed. Changes made by the test are not isolated from the test suite and from the following tests.
  *
- * \param EXPRESSION Expression to verify.
+ * \param DESCRIPTION String literal to describe the test.
+ * \param BEFORE Function of type tric_fixture_t that will be executed before the test is run. May be NULL.
+ * \param AFTER Function of type tric_fixture_t that will be executed after the test is run. May be NULL.
+ * \param DATA User data that is passed to the before and after functions.
  */
-#define ASSERT(EXPRESSION) \
-if ( (EXPRESSION) == false) { \
-    lseek(tric_context->self, __LINE__, SEEK_SET); \
-    _exit(EXIT_TEST_FAILURE); \
-}
+#define INLINE_TEST(DESCRIPTION, BEFORE, AFTER, DATA) \
+    TEST_WITH(DESCRIPTION, BEFORE, AFTER, DATA, .execution = TRIC_EXECUTE_INLINE)
 
 
 
 /**
- * \brief Mark code inside the test suite as fixture code.
+ * \brief Create a test with tags.
  *
- * Arbitrary code placed inside the test suite but outside of a test is executed twice (during scanning and when executing the tests). To prevent e.g. malloc() from running twice, the code can be placed in a fixture block.
+ * The TAGGED_TEST macro works like the TEST macro, but sets the tags of the test (see struct tric_options). The environment variable TRIC_TAGS selects the tests to execute by their tags, e.g. "!slow" to skip all tests tagged with slow.
  *
- * \param DESCRIPTION String literal to describe the purpose of the fixture. May be omitted.
+ * \param DESCRIPTION String literal to describe the test.
+ * \param TAGS String literal with a comma separated list of tags, e.g. "slow,io".
+ * \param BEFORE Function of type tric_fixture_t that will be executed before the test is run. May be NULL.
+ * \param AFTER Function of type tric_fixture_t that will be executed after the test is run. May be NULL.
+ * \param DATA User data that is passed to the before and after functions.
  */
-#define FIXTURE(DESCRIPTION) \
-if (tric_context->mode == MODE_RESET)
-
-
-
-struct tric_suite;
-struct tric_test;
-struct tric_context;
-struct tric_reporting_data *tric_report(void);
-const struct tric_suite_data *tric_data(void);
-void tric_suite_function(struct tric_context *tric_context);
+#define TAGGED_TEST(DESCRIPTION, TAGS, BEFORE, AFTER, DATA) \
+    TEST_WITH(DESCRIPTION, BEFORE, AFTER, DATA, .tags = TAGS)
 
 
 
 /**
- * \brief Prototype of a log function.
+ * \brief Create a test for each case of a table.
  *
- * \param suite Pointer to the test suite.
- * \param test Pointer to the test that was executed just before the log function is called. If the log function is called at the start or end of the test suite, test is NULL.
- * \param data User data that will be passed to the log function.
+ * The TEST_EACH macro works like the TEST macro, but creates COUNT tests executing the same code, e.g. one test for each entry of an array of test data. Inside the test, TEST_INDEX is the index of the current case. The description of each test is DESCRIPTION followed by the index in brackets.
+ *
+ * COUNT is evaluated once when the tests of the test suite are found. The tests are allocated together in a single block and are never executed in the process of the test suite.
+ *
+ * \param DESCRIPTION String to describe the tests.
+ * \param COUNT Number of tests to create.
+ * \param BEFORE Function of type tric_fixture_t that will be executed before each test is run. May be NULL.
+ * \param AFTER Function of type tric_fixture_t that will be executed after each test is run. May be NULL.
+ * \param DATA User data that is passed to the before and after functions.
  */
-typedef void (*tric_logger_t)(struct tric_suite *suite, struct tric_test *test, void *data);
+#define TEST_EACH(DESCRIPTION, COUNT, BEFORE, AFTER, DATA) \
+    TEST_EACH_WITH(DESCRIPTION, COUNT, BEFORE, AFTER, DATA, .execution = TRIC_EXECUTE_DEFAULT)
 
 
 
 /**
- * \brief Prototype of a test fixture.
+ * \brief Create a test with options for each case of a table.
  *
- * \param data User data that will be passed to the fixture
- * \return Should return true when the fixture can execute without any failure. Otherwise false should be returned to indicate a problem.
+ * The TEST_EACH_WITH macro works like the TEST_EACH macro. Additionally the options of the tests (see struct tric_options) can be passed as designated initializers after the DATA argument.
+ *
+ * \param DESCRIPTION String to describe the tests.
+ * \param COUNT Number of tests to create.
+ * \param BEFORE Function of type tric_fixture_t that will be executed before each test is run. May be NULL.
+ * \param AFTER Function of type tric_fixture_t that will be executed after each test is run. May be NULL.
+ * \param DATA User data that is passed to the before and after functions.
+ * \param ... Designated initializers of struct tric_options.
  */
-typedef bool (*tric_fixture_t)(void *data);
+#define TEST_EACH_WITH(DESCRIPTION, COUNT, BEFORE, AFTER, DATA, ...) \
+    TEST_EACH_ID(TRIC_COUNTER, DESCRIPTION, COUNT, BEFORE, AFTER, DATA, __VA_ARGS__)
 
 
 
 /*
 internally used
-function to set the result status of a test
+create tests for each case with a unique ID in the file and execute them one after another
 */
-typedef void (*tric_status_t)(struct tric_context *context, bool before, bool after);
+#define TEST_EACH_ID(ID, DESCRIPTION, COUNT, BEFORE, AFTER, DATA, ...) \
+    static struct tric_each UNIQUE_NAME(tric_each, ID) = { .description = DESCRIPTION, .options = { __VA_ARGS__ }, .count = 0, .tests = NULL }; \
+    REGISTER_EACH(ID) \
+    tric_add_each(tric_context, &(UNIQUE_NAME(tric_each, ID)), (COUNT)); \
+    for (size_t tric_index = 0; tric_next_case(tric_context, &(UNIQUE_NAME(tric_each, ID)), tric_index); tric_index++) \
+    for ( \
+        tric_run_test(tric_context, (BEFORE) ? true : false, (AFTER) ? true : false), tric_run_before(tric_context, (BEFORE), (DATA)); \
+        (tric_context->mode == MODE_EXECUTE) && ((tric_context->mode = MODE_RESET) == MODE_RESET); \
+        tric_run_after(tric_context, (AFTER), (DATA)) \
+    )
 
 
 
 /*
 internally used
-exit status of child process running a test
+add an entry without test to the linker section, so the test suite is scanned for the tests created for each case
 */
-enum tric_exit {
-    EXIT_OK = 0,
-    EXIT_TEST_FAILURE,
-    EXIT_BEFORE_FAILURE,
-    EXIT_AFTER_FAILURE,
-    EXIT_SIGNAL,
-    EXIT_FORK,
-    EXIT_SKIP
+#ifdef TRIC_SECTIONS
+#define REGISTER_EACH(ID) \
+    static struct tric_entry UNIQUE_NAME(tric_entry, ID) __attribute__((section("tric_tests"), used)) = { .test = NULL, .order = ID };
+#else
+#define REGISTER_EACH(ID)
+#endif
+
+
+
+/**
+ * \brief Index of the case of a test created with the TEST_EACH macro.
+ *
+ * TEST_INDEX can only be used inside a test created with the TEST_EACH macro.
+ */
+#define TEST_INDEX (tric_context->test->index)
+
+
+
+/**
+ * \brief Create a test that is skipped.
+ *
+ * The description of the test should not be omitted. All other arguments can be omitted by setting them to NULL. The code of the test as well as the BEFORE and AFTER functions are not executed and the test is marked as skipped.
+ *
+ * \param DESCRIPTION String literal to describe the test.
+ * \param BEFORE Function of type tric_fixture_t that would be executed before the test would be run. May be NULL.
+ * \param AFTER Function of type tric_fixture_t that would be executed after the test would be run. May be NULL.
+ * \param DATA User data that would be passed to the before and after functions.
+ */
+#define SKIP_TEST(DESCRIPTION, BEFORE, AFTER, DATA) \
+    PREPARE_TEST(DESCRIPTION) \
+    tric_skip_test_execution(tric_context, (BEFORE), (AFTER)); \
+    if (false)
+
+
+
+/**
+ * \brief Create a test with options that is skipped.
+ *
+ * The SKIP_TEST_WITH macro has the same signature as the TEST_WITH macro. The test is skipped like a test created with the SKIP_TEST macro.
+ *
+ * \param DESCRIPTION String literal to describe the test.
+ * \param BEFORE Function of type tric_fixture_t that would be executed before the test would be run. May be NULL.
+ * \param AFTER Function of type tric_fixture_t that would be executed after the test would be run. May be NULL.
+ * \param DATA User data that would be passed to the before and after functions.
+ * \param ... Designated initializers of struct tric_options.
+ */
+#define SKIP_TEST_WITH(DESCRIPTION, BEFORE, AFTER, DATA, ...) \
+    PREPARE_TEST_WITH(DESCRIPTION, __VA_ARGS__) \
+    tric_skip_test_execution(tric_context, (BEFORE), (AFTER)); \
+    if (false)
+
+
+
+/**
+ * \brief Verify an expression.
+ *
+ * The given expression is executed and if it is false, the test is terminated and marked as failed. If the expression is true, nothing happens and the execution of the test continues.
+ *
+ * there can be any number of ASSERTs per test. Since ASSERT terminates the calling process (or jumps back to the test suite if the test is executed in the process of the test suite), it should not be used outside of a test.
+ *
+ * \param EXPRESSION Expression to verify.
+ */
+#define ASSERT(EXPRESSION) \
+if (tric_context->record->assertions++, (EXPRESSION) == false) { \
+    tric_fail(tric_context, __FILE__, __LINE__); \
+}
+
+
+
+/**
+ * \brief Mark code inside the test suite as fixture code.
+ *
+ * Arbitrary code placed inside the test suite but outside of a test is executed twice (during scanning and when executing the tests) unless the tests are registered in a linker section (see TRIC_NO_SECTIONS). To prevent e.g. malloc() from running twice, the code can be placed in a fixture block.
+ *
+ * When tests are executed in parallel, a fixture block waits for all tests started before it to finish before its code is executed.
+ *
+ * \param DESCRIPTION String literal to describe the purpose of the fixture. May be omitted.
+ */
+#define FIXTURE(DESCRIPTION) \
+if (tric_fixture(tric_context))
+
+
+
+struct tric_suite;
+struct tric_test;
+struct tric_context;
+struct tric_reporting_data *tric_report(void);
+const struct tric_suite_data *tric_data(void);
+void tric_suite_function(struct tric_context *tric_context);
+
+
+
+/**
+ * \brief Prototype of a log function.
+ *
+ * \param suite Pointer to the test suite.
+ * \param test Pointer to the test that was executed just before the log function is called. If the log function is called at the start or end of the test suite, test is NULL.
+ * \param data User data that will be passed to the log function.
+ */
+typedef void (*tric_logger_t)(struct tric_suite *suite, struct tric_test *test, void *data);
+
+
+
+/**
+ * \brief Prototype of a test fixture.
+ *
+ * \param data User data that will be passed to the fixture
+ * \return Should return true when the fixture can execute without any failure. Otherwise false should be returned to indicate a problem.
+ */
+typedef bool (*tric_fixture_t)(void *data);
+
+
+
+/*
+internally used
+function to set the result status of a test
+*/
+typedef void (*tric_status_t)(struct tric_context *context, bool before, bool after);
+
+
+
+/*
+internally used
+exit status of child process running a test
+*/
+enum tric_exit {
+    EXIT_OK = 0,
+    EXIT_TEST_FAILURE,
+    EXIT_BEFORE_FAILURE,
+    EXIT_AFTER_FAILURE,
+    EXIT_SIGNAL,
+    EXIT_FORK,
+    EXIT_SKIP,
+    EXIT_TIMEOUT,
+    EXIT_EXCEEDED,
+    EXIT_NOT_IN_SHARD,
+    EXIT_NOT_RUN,
+    EXIT_DEFERRED,
+    EXIT_NOT_STARTED
 };
 
 
@@ -298,7 +772,32 @@ enum tric_result {
     /**
      * \brief Execution failed due to signal
      */
-    TRIC_CRASHED
+    TRIC_CRASHED,
+
+    /**
+     * \brief Execution was terminated since it took longer than its timeout
+     */
+    TRIC_TIMEOUT,
+
+    /**
+     * \brief Execution was terminated since it exceeded a resource limit
+     */
+    TRIC_EXCEEDED,
+
+    /**
+     * \brief Not executed since the test belongs to another shard of the test suite
+     */
+    TRIC_NOT_IN_SHARD,
+
+    /**
+     * \brief Not executed or terminated since the test suite was stopped after too many failures
+     */
+    TRIC_NOT_RUN,
+
+    /**
+     * \brief Not executed since the test did not fit into the time budget of the test suite, left for a later run
+     */
+    TRIC_DEFERRED
 };
 
 
@@ -315,6 +814,171 @@ enum tric_mode {
 
 
 
+/**
+ * \brief Execution of tests.
+ *
+ * By default each test is executed in a separate process. Tests that do not need to be isolated can be executed in the process of the test suite, which avoids the cost of forking a process for each test.
+ */
+enum tric_execution {
+
+    /**
+     * \brief Execute the test as set for the test suite with tric_execute()
+     */
+    TRIC_EXECUTE_DEFAULT = 0,
+
+    /**
+     * \brief Execute the test in a separate process
+     */
+    TRIC_EXECUTE_FORK,
+
+    /**
+     * \brief Execute the test in the process of the test suite
+     */
+    TRIC_EXECUTE_INLINE,
+
+    /**
+     * \brief Execute the test in a new process of the test suite started with posix_spawn()
+     *
+     * The new process does not copy the address space of the process of the test suite. It executes the setup function of the test suite and the fixture blocks before the test itself. If spawning is not supported (it needs Linux), the test is executed in a forked process.
+     */
+    TRIC_EXECUTE_SPAWN
+};
+
+
+
+/**
+ * \brief Options of a test.
+ *
+ * The options of a test are passed as designated initializers to the TEST_WITH macro. Options that are not set are 0, which selects the default behaviour.
+ */
+struct tric_options {
+
+    /**
+     * \brief Execution of the test
+     */
+    enum tric_execution execution;
+
+    /**
+     * \brief Timeout of the test in seconds
+     *
+     * If the timeout is not set, the timeout set with the environment variable TRIC_TEST_TIMEOUT is used. Tests executed in the process of the test suite have no timeout.
+     */
+    double timeout;
+
+    /**
+     * \brief Maximum size of the address space of the test process in bytes (RLIMIT_AS)
+     *
+     * Resource limits are only applied to tests executed in a separate process. A value of 0 sets no limit. If the test is terminated by SIGKILL or SIGABRT while a memory limit is set, the test is marked with TRIC_EXCEEDED.
+     */
+    size_t memory_limit;
+
+    /**
+     * \brief Maximum CPU time of the test process in seconds (RLIMIT_CPU)
+     *
+     * If the test is terminated by SIGXCPU, it is marked with TRIC_EXCEEDED.
+     */
+    size_t cpu_limit;
+
+    /**
+     * \brief Maximum number of files the test process can open (RLIMIT_NOFILE)
+     */
+    size_t file_limit;
+
+    /**
+     * \brief Maximum size of files written by the test process in bytes (RLIMIT_FSIZE)
+     *
+     * If the test is terminated by SIGXFSZ, it is marked with TRIC_EXCEEDED.
+     */
+    size_t output_limit;
+
+    /**
+     * \brief Allow the test process to write a core dump when it crashes
+     *
+     * By default core dumps of test processes are disabled (RLIMIT_CORE is set to 0), since writing them can take much longer than the test itself. The environment variable TRIC_CORE_DUMP set to 1 allows core dumps for all tests.
+     */
+    bool core_dump;
+
+    /**
+     * \brief Execute the before function of the test only once for consecutive tests sharing it
+     *
+     * Consecutive tests with this option that have the same before function and data are executed by a process that executes the before function once and forks a process for each test afterwards. The tests are still isolated from each other, but see the state prepared by the shared before function. The option is ignored if the tests are executed in parallel or not in a forked process.
+     */
+    bool share_before;
+
+    /**
+     * \brief Number of times the test must pass
+     *
+     * If the repeat is not set, the number set with the environment variable TRIC_REPEAT is used (1 by default). The test is failed at its first failing run unless it has retries left. The timeout of the test applies to all runs together. Tests executed in the process of the test suite are executed once.
+     */
+    size_t repeat;
+
+    /**
+     * \brief Number of times a failing run of the test is executed again
+     *
+     * If the retries are not set, the number set with the environment variable TRIC_RETRIES is used (0 by default).
+     */
+    size_t retries;
+
+    /**
+     * \brief Comma separated list of tags of the test, e.g. "slow,io"
+     *
+     * The environment variable TRIC_TAGS selects the tests to execute by their tags. The tags are reported by the output formats of tric_output.h.
+     */
+    const char *tags;
+};
+
+
+
+/*
+internally used
+global execution settings of the test suite
+*/
+struct tric_settings {
+    enum tric_execution execution;
+    double timeout;
+    bool backtrace;
+    bool core_dump;
+    size_t repeat;
+    size_t retries;
+
+    /*
+    pattern matching the descriptions, list of the IDs and list of the tags of the selected tests, NULL to select all tests
+    */
+    const char *filter;
+    const char *tests;
+    const char *tags;
+
+    /*
+    number of shards of the test suite and shard executed, file of the history of the tests, NULL if not used
+    */
+    size_t shard_count;
+    size_t shard_index;
+    const char *history;
+
+    /*
+    start the tests that failed in the previous run first or execute only these tests
+    */
+    bool failed_first;
+    bool rerun_failed;
+
+    /*
+    number of failed tests after which no further tests are executed, 0 to execute all tests
+    */
+    size_t max_failures;
+
+    /*
+    time available to execute the test suite in seconds, 0 to execute all tests
+    */
+    double time_budget;
+
+    /*
+    maximum number of tests executed in parallel
+    */
+    size_t jobs;
+};
+
+
+
 /*
 internally used
 structure of global data
@@ -328,6 +992,17 @@ struct tric_suite_data {
 
 
 
+/*
+internally used
+entry of a test suite in the linker section of the test suites linked into one runner
+*/
+struct tric_suite_entry {
+    const struct tric_suite_data *data;
+    void (*function)(struct tric_context *tric_context);
+};
+
+
+
 /**
  * \brief Test suite data.
  *
@@ -360,10 +1035,46 @@ struct tric_suite {
      */
     size_t skipped_tests;
 
+    /**
+     * \brief Number of tests that were not executed since they belong to another shard of the test suite
+     */
+    size_t not_in_shard_tests;
+
+    /**
+     * \brief Number of tests that were not executed or terminated since the test suite was stopped after too many failures
+     */
+    size_t not_run_tests;
+
+    /**
+     * \brief Number of tests that were not executed since they did not fit into the time budget of the test suite
+     */
+    size_t deferred_tests;
+
+    /**
+     * \brief Time in seconds from the start of the first test until the last test finished (the makespan of the test suite)
+     */
+    double duration;
+
+    /**
+     * \brief CPU time in seconds used by all tests of the test suite (user and system time)
+     *
+     * If the tests are executed in parallel, the CPU time divided by the duration shows how well the processors were used.
+     */
+    double cpu_time;
+
     /**
      * \brief Linked list of the tests found in the test suite
+     *
+     * Before the tests are executed, the list is moved into the table of the tests. Following the list then visits the table in the order of the IDs.
      */
     struct tric_test *tests;
+
+    /**
+     * \brief Tests of the test suite stored contiguously in the order of their IDs
+     *
+     * The test with ID n is stored at index n - 1. The table is NULL while the test suite is scanned for tests. Use tric_suite_test() to look up a test by its ID.
+     */
+    struct tric_test *table;
 };
 
 
@@ -371,7 +1082,7 @@ struct tric_suite {
 /**
  * \brief Test data.
  *
- * The description of the test is specified by the first argument of the TEST macro. The line property is only set if the test fails due to a failing ASSERT, otherwise it is 0. The signal property is only set if the test crashes due to a signal, otherwise it is 0.
+ * The description of the test is specified by the first argument of the TEST macro. The line and file properties are only set if the test fails due to a failing ASSERT, otherwise they are 0 and NULL. The signal property is only set if the test crashes due to a signal, otherwise it is 0.
  */
 struct tric_test {
 
@@ -411,32 +1122,462 @@ struct tric_test {
     size_t signal;
 
     /**
-     * \brief Next test in the linked list
+     * \brief Number of frames in the backtrace of the crashed test
      *
-     * If the test is the last test found in the test suite, next is NULL.
+     * The backtrace is only recorded if the environment variable TRIC_BACKTRACE is set to 1 and the GNU C library is used, otherwise frames is 0.
      */
-    struct tric_test *next;
-};
+    size_t frames;
 
+    /**
+     * \brief Return addresses of the innermost functions active when the test crashed
+     *
+     * The addresses belong to the address space of the test suite and can be resolved with backtrace_symbols(). The first frames belong to the signal handling, e.g. to abort().
+     */
+    void *backtrace[TRIC_BACKTRACE_FRAMES];
 
+    /**
+     * \brief Number of times the test was executed
+     *
+     * A test is executed several times if it has a repeat or retries (see struct tric_options). Then the line, file, signal and assertions of the test are taken from its last run, while the execution time and the resource usage include all runs.
+     */
+    size_t runs;
 
-/*
-internally used
-execution context of suite function
+    /**
+     * \brief Number of failed runs of the test
+     *
+     * A test that passed with failed runs passed after a retry, which indicates a flaky test.
+     */
+    size_t failed_runs;
+
+    /**
+     * \brief Index of the case of a test created with the TEST_EACH macro
+     */
+    size_t index;
+
+    /**
+     * \brief Number of cases of the TEST_EACH macro that created the test, 0 for other tests
+     */
+    size_t cases;
+
+    /**
+     * \brief Shard of the test suite the test belongs to (see TRIC_SHARD_COUNT)
+     */
+    size_t shard;
+
+    /**
+     * \brief True if the test is left for a later run since it does not fit into the time budget of the test suite (see TRIC_TIME_BUDGET)
+     */
+    bool deferred;
+
+    /**
+     * \brief True if the test is executed although its previous duration exceeds the time budget, otherwise such a test would be deferred in every run
+     */
+    bool over_budget;
+
+    /**
+     * \brief Result of the test in the previous run recorded in the history file, TRIC_UNDEFINED if unknown (see TRIC_HISTORY)
+     */
+    enum tric_result previous_result;
+
+    /**
+     * \brief Duration of the test in seconds in the previous run recorded in the history file, negative if unknown (see TRIC_HISTORY)
+     */
+    double previous_duration;
+
+    /**
+     * \brief Source file of failing assert
+     */
+    const char *file;
+
+    /**
+     * \brief Number of asserts evaluated by the test
+     */
+    size_t assertions;
+
+    /**
+     * \brief Execution time of the test in seconds
+     *
+     * The execution time is measured with a monotonic clock from the start of the test until the test (and its after function) finished. If the test crashed, the execution time is measured until the process of the test suite noticed the end of the test process.
+     */
+    double duration;
+
+    /**
+     * \brief CPU time of the test in user mode in seconds
+     *
+     * The resource usage of a test is determined from the resource usage of the process executing the test. If several tests are executed in the same process, only the resource usage since the start of the test is counted.
+     */
+    double user_time;
+
+    /**
+     * \brief CPU time of the test in kernel mode in seconds
+     */
+    double system_time;
+
+    /**
+     * \brief Maximum resident set size of the process executing the test in kilobytes
+     *
+     * The maximum resident set size includes the memory used by the process before the test was started (e.g. by preceding tests executed in the same process).
+     */
+    size_t max_rss;
+
+    /**
+     * \brief Number of page faults of the test serviced without I/O
+     */
+    size_t minor_faults;
+
+    /**
+     * \brief Number of page faults of the test that required I/O
+     */
+    size_t major_faults;
+
+    /**
+     * \brief Number of voluntary context switches of the test
+     */
+    size_t voluntary_switches;
+
+    /**
+     * \brief Number of involuntary context switches of the test
+     */
+    size_t involuntary_switches;
+
+    /**
+     * \brief Number of processes started by the test that were still running after the test finished
+     *
+     * These processes are killed by the process of the test suite. If several tests are executed in the same process, the processes are counted for the last test executed in the process.
+     */
+    size_t stragglers;
+
+    /**
+     * \brief Options of the test
+     */
+    struct tric_options options;
+
+    /**
+     * \brief Next test in the linked list
+     *
+     * If the test is the last test found in the test suite, next is NULL.
+     */
+    struct tric_test *next;
+};
+
+
+
+/*
+internally used
+entry of a test in the linker section of the tests
+the test is NULL for the tests created for each case of a table, which are only found by scanning the test suite
 */
-struct tric_context {
+struct tric_entry {
+    struct tric_test *test;
+
+    /*
+    position of the test in the file of the test suite
+    */
+    size_t order;
+};
+
+
+
+/*
+internally used
+tests created for each case of a table, allocated together when the test suite is scanned
+*/
+struct tric_each {
+    const char *description;
+    struct tric_options options;
+    size_t count;
+    struct tric_test *tests;
+};
+
+
+
+#ifdef TRIC_SECTIONS
+/*
+internally used
+start and end of the linker section of the tests, NULL if the test suite contains no tests
+*/
+extern struct tric_entry __start_tric_tests[] __attribute__((weak));
+extern struct tric_entry __stop_tric_tests[] __attribute__((weak));
+#endif
+
+
+
+#ifdef TRIC_MULTIPLE_SUITES
+/*
+internally used
+start and end of the linker section of the test suites linked into one runner
+*/
+extern const struct tric_suite_entry __start_tric_suites[] __attribute__((weak));
+extern const struct tric_suite_entry __stop_tric_suites[] __attribute__((weak));
+#endif
+
+
+
+/*
+internally used
+result data written by the process executing a test
+shared with the process of the test suite
+*/
+struct tric_record {
+
+    /*
+    set by the process of the test suite while a test uses the result
+    */
+    bool used;
+    size_t line;
+    const char *file;
+    size_t assertions;
+    struct timespec start;
+    struct timespec end;
+
+    /*
+    resource usage of the process executing the test at the start of the test
+    and at the end of the test, which is set by the process of the test suite
+    */
+    struct rusage start_usage;
+    struct rusage end_usage;
+
+    /*
+    timeout of the test in seconds, 0 if the test has no timeout
+    */
+    double timeout;
+
+    /*
+    number of killed processes left by the test, set by the process of the test suite
+    */
+    size_t stragglers;
+
+    /*
+    backtrace recorded by the signal handler of a crashing test
+    */
+    size_t frames;
+    void *backtrace[TRIC_BACKTRACE_FRAMES];
+
+    /*
+    result of a test executed by the process of a shared before function, set by this process when the test finished
+    */
+    bool finished;
+    enum tric_exit status;
+    int signal;
+
+    /*
+    number of runs and failed runs of a test executed several times, set by the process executing the runs
+    */
+    size_t runs;
+    size_t failed_runs;
+
+    /*
+    address of the test suite data in a spawned process executing the test, NULL for forked processes
+    pointers written by a spawned process are relative to it
+    */
+    const char *origin;
 
-    /* 
-   file descriptor to detect the line at which an assertion failed
+    /*
+    fixtures of the test, needed to set the status of tests executed in a batch
     */
-    int self;
+    bool before;
+    bool after;
+};
+
+
+
+/*
+internally used
+test executed in parallel that is waiting to be reported
+*/
+struct tric_job {
+    struct tric_test *test;
+    struct tric_record *record;
+    pid_t pid;
+
+    /*
+    file descriptor to wait for the process with poll, -1 if not supported
+    */
+    int pidfd;
+    bool before;
+    bool after;
+    bool finished;
+    bool timed_out;
+
+    /*
+    terminated since the test suite was stopped after too many failures, or held and terminated since the time budget was used up (deferred)
+    */
+    bool cancelled;
+
+    /*
+    waiting to be started in the order of the ranks, the process of a forked test waits until the write end of its pipe is closed
+    a spawned test has no process before it is started
+    */
+    bool held;
+    int release;
+    bool deferred;
+};
+
+
+
+/*
+internally used
+tests executed in parallel in the order they were reached in the test suite
+with a schedule, each test is forked when it is reached but held until it is started in the order of its rank
+*/
+struct tric_queue {
+
+    /*
+    maximum number of tests running at the same time
+    */
+    size_t jobs;
+    size_t running;
+    size_t held;
+    size_t capacity;
+    size_t head;
+    size_t length;
+    struct tric_job *entries;
+
+    /*
+    rank of each test by ID, held tests with a lower rank are started first, NULL to start each test when it is reached
+    */
+    size_t *ranks;
+};
+
+
+
+/*
+internally used
+tests executed one after another in the same process
+*/
+struct tric_batch {
+
+    /*
+    maximum number of tests executed in the same process, batches are disabled if less than 2
+    */
+    size_t size;
+
+    /*
+    stop starting tests in the same process after TRIC_BATCH_TIME seconds
+    */
+    bool adaptive;
+
+    /*
+    set in the process executing the batch
+    */
+    bool child;
+    size_t length;
+    struct timespec start;
+
+    /*
+    number of following tests already executed by the last batch
+    */
+    size_t pending;
+
+    /*
+    set if the process executes a group of tests sharing a before function, each test in a forked process
+    before function and data shared by the group, set in this process after the before function was executed
+    */
+    bool shared;
+    tric_fixture_t before;
+    void *data;
+};
+
+
+
+/*
+internally used
+state of a test executed in the process of the test suite
+*/
+struct tric_inline {
+
+    /*
+    position in the suite function to return to when the test is terminated
+    */
+    sigjmp_buf jump;
+
+    /*
+    record used by the test instead of the shared record of the context
+    */
+    struct tric_record record;
+    struct tric_record *shared;
+    bool before;
+    bool after;
+    enum tric_exit status;
+    int signal;
+};
+
+
+
+/*
+internally used
+execution context of suite function
+*/
+struct tric_context {
     enum tric_mode mode;
     struct tric_suite * const suite;
     struct tric_test *test;
+
+    /*
+    record written by the process executing the current test
+    */
+    struct tric_record *record;
+
+    /*
+    shared memory with a record for each test that can run at the same time
+    file of the shared memory passed to spawned processes, -1 if not available
+    */
+    struct tric_record *records;
+    size_t number_of_records;
+    int records_file;
+
+    /*
+    ID of the only test executed by a spawned process, 0 in the process of the test suite
+    */
+    size_t spawned;
+
+    /*
+    tests running in parallel, NULL if tests are executed one after another
+    */
+    struct tric_queue *queue;
+    struct tric_batch batch;
+    struct tric_inline inline_test;
+
+    /*
+    start of the execution of the tests, to defer tests when the time budget is used up
+    */
+    struct timespec start;
 };
 
 
 
+#ifndef TRIC_DEFINITIONS
+/*
+internally used
+functions used by the macros of the test suites, defined in the file of the runner or in the library
+*/
+void tric_add_test(struct tric_context *context, struct tric_test *test);
+void tric_reset_context(struct tric_context *context, struct tric_test *test);
+void tric_add_each(struct tric_context *context, struct tric_each *each, size_t count);
+bool tric_next_case(struct tric_context *context, struct tric_each *each, size_t index);
+bool tric_run_test(struct tric_context *context, bool before, bool after);
+void tric_resume_inline(struct tric_context *context);
+void tric_run_before(struct tric_context *context, tric_fixture_t before, void *data);
+void tric_run_after(struct tric_context *context, tric_fixture_t after, void *data);
+void tric_skip_test_execution(struct tric_context *context, tric_fixture_t before, tric_fixture_t after);
+bool tric_fixture(struct tric_context *context);
+void tric_fail(struct tric_context *context, const char *file, size_t line);
+void tric_log(tric_logger_t start, tric_logger_t test, tric_logger_t end, void *data);
+void tric_execute(enum tric_execution execution);
+struct tric_test *tric_suite_test(struct tric_suite *suite, size_t id);
+#endif
+
+
+
+#ifdef TRIC_DEFINITIONS
+/*
+internally used
+environment of the process of the test suite, passed to spawned processes
+*/
+extern char **environ;
+
+
+
 /*
 internally used
 data used for reporting test results
@@ -463,365 +1604,3359 @@ void tric_add_test(struct tric_context *context, struct tric_test *test) {
     } else {
         context->suite->tests = test;
     }
-    context->test = test;
-    context->suite->number_of_tests++;
-    test->id = context->suite->number_of_tests;
+    context->test = test;
+    context->suite->number_of_tests++;
+    test->id = context->suite->number_of_tests;
+}
+
+
+
+/*
+internally used
+return the entry of the test in the table of the test suite, the results of the tests are only written to the table
+*/
+struct tric_test *tric_stored_test(struct tric_suite *suite, struct tric_test *test) {
+    if (suite == NULL || suite->table == NULL || test->id == 0 || test->id > suite->number_of_tests) {
+        return test;
+    }
+    return &suite->table[test->id - 1];
+}
+
+
+
+/*
+internally used
+prepare execution context to run test
+*/
+void tric_reset_context(struct tric_context *context, struct tric_test *test) {
+    if (context->mode != MODE_RESET) {
+        return;
+    }
+    context->mode = MODE_EXECUTE;
+    context->test = tric_stored_test(context->suite, test);
+}
+
+
+
+/*
+internally used
+write description of a case followed by its index in brackets, return the position after the terminating null character
+*/
+char *tric_describe_case(char *position, const char *description, size_t length, size_t index) {
+    char digits[24];
+    size_t number_of_digits = 0;
+    do {
+        digits[number_of_digits++] = '0' + index % 10;
+        index /= 10;
+    } while (index > 0);
+    memcpy(position, description, length);
+    position += length;
+    *position++ = ' ';
+    *position++ = '[';
+    while (number_of_digits > 0) {
+        *position++ = digits[--number_of_digits];
+    }
+    *position++ = ']';
+    *position++ = '\0';
+    return position;
+}
+
+
+
+/*
+internally used
+create the tests for each case of a table and their descriptions in a single allocation and add them to the suite
+*/
+void tric_add_each(struct tric_context *context, struct tric_each *each, size_t count) {
+    if (context->mode != MODE_SCAN || count == 0) {
+        return;
+    }
+    size_t length = strlen(each->description);
+    /* description, space, brackets and null character */
+    size_t size = count * (length + 4);
+    size_t limit;
+    for (limit = 10; limit <= count; limit *= 10) {
+        size += count - limit;
+    }
+    size += count;
+    each->tests = malloc(count * sizeof(struct tric_test) + size);
+    if (each->tests == NULL) {
+        exit(EX_OSERR);
+    }
+    each->count = count;
+    char *position = (char *)(each->tests + count);
+    size_t i;
+    for (i = 0; i < count; i++) {
+        each->tests[i] = (struct tric_test)NEW_TEST(position);
+        each->tests[i].options = each->options;
+        each->tests[i].index = i;
+        each->tests[i].cases = count;
+        position = tric_describe_case(position, each->description, length, i);
+        tric_add_test(context, &each->tests[i]);
+    }
+}
+
+
+
+/*
+internally used
+prepare execution context to run the test of the next case of a table
+*/
+bool tric_next_case(struct tric_context *context, struct tric_each *each, size_t index) {
+    if (context->mode != MODE_RESET || index >= each->count) {
+        return false;
+    }
+    context->mode = MODE_EXECUTE;
+    context->test = tric_stored_test(context->suite, &each->tests[index]);
+    return true;
+}
+
+
+
+/*
+internally used
+create file in memory for the records of the tests, which can be mapped by spawned processes
+return -1 if not supported
+*/
+int tric_create_records_file(size_t number_of_records) {
+#ifdef SYS_memfd_create
+    int file = syscall(SYS_memfd_create, "tric", 0);
+    if (file >= 0 && ftruncate(file, number_of_records * sizeof(struct tric_record)) == -1) {
+        close(file);
+        return -1;
+    }
+    return file;
+#else
+    return -1;
+#endif
+}
+
+
+
+/*
+internally used
+map shared memory for the records of the tests that can run at the same time
+the memory is anonymous if no file is given
+*/
+struct tric_record *tric_map_records(size_t number_of_records, int file) {
+    int flags = file < 0 ? MAP_SHARED | MAP_ANONYMOUS : MAP_SHARED;
+    void *records = mmap(NULL, number_of_records * sizeof(struct tric_record), PROT_READ | PROT_WRITE, flags, file, 0);
+    return records == MAP_FAILED ? NULL : records;
+}
+
+
+
+/*
+internally used
+release shared memory for the records of the tests
+*/
+void tric_unmap_records(struct tric_record *records, size_t number_of_records) {
+    munmap(records, number_of_records * sizeof(struct tric_record));
+}
+
+
+
+/*
+internally used
+find record that is not used by a running test
+*/
+struct tric_record *tric_unused_record(struct tric_context *context) {
+    size_t i;
+    for (i = 0; i < context->number_of_records; i++) {
+        if (context->records[i].used == false) {
+            return &context->records[i];
+        }
+    }
+    return NULL;
+}
+
+
+
+/*
+internally used
+function to hold the record of the test executed in the current process to record a backtrace when the test crashes
+*/
+struct tric_record *tric_crash_record(bool set, struct tric_record *record) {
+    static struct tric_record *current = NULL;
+    if (set) {
+        current = record;
+    }
+    return current;
+}
+
+
+
+/*
+internally used
+record backtrace of a crashing test in its record
+the frame of this function is omitted
+*/
+void tric_record_backtrace(struct tric_record *record) {
+#ifdef __GLIBC__
+    void *frames[TRIC_BACKTRACE_FRAMES + 1];
+    int size = backtrace(frames, TRIC_BACKTRACE_FRAMES + 1);
+    if (size > 1) {
+        memcpy(record->backtrace, frames + 1, (size - 1) * sizeof(void *));
+        record->frames = size - 1;
+    }
+#endif
+}
+
+
+
+/*
+internally used
+clear record before a test is executed
+*/
+void tric_reset_record(struct tric_record *record) {
+    *record = (struct tric_record){ .used = true, .line = 0, .file = NULL, .assertions = 0 };
+}
+
+
+
+/*
+internally used
+record start time in the process executing the test
+*/
+void tric_start_record(struct tric_context *context) {
+    tric_crash_record(true, context->record);
+    getrusage(RUSAGE_SELF, &context->record->start_usage);
+    clock_gettime(CLOCK_MONOTONIC, &context->record->start);
+}
+
+
+
+/*
+internally used
+record end time in the process executing the test
+*/
+void tric_end_record(struct tric_context *context) {
+    clock_gettime(CLOCK_MONOTONIC, &context->record->end);
+}
+
+
+
+/*
+internally used
+calculate time between two points in time in seconds
+*/
+double tric_seconds(const struct timespec *start, const struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+
+/*
+internally used
+calculate difference of two cpu times in seconds
+*/
+double tric_cpu_seconds(const struct timeval *start, const struct timeval *end) {
+    return (end->tv_sec - start->tv_sec) + (end->tv_usec - start->tv_usec) / 1e6;
+}
+
+
+
+/*
+internally used
+copy resource usage of the test from the resource usage of the process executing the test
+*/
+void tric_read_usage(struct tric_test *test, const struct rusage *start, const struct rusage *end) {
+    test->user_time = tric_cpu_seconds(&start->ru_utime, &end->ru_utime);
+    test->system_time = tric_cpu_seconds(&start->ru_stime, &end->ru_stime);
+    test->max_rss = end->ru_maxrss;
+    test->minor_faults = end->ru_minflt - start->ru_minflt;
+    test->major_faults = end->ru_majflt - start->ru_majflt;
+    test->voluntary_switches = end->ru_nvcsw - start->ru_nvcsw;
+    test->involuntary_switches = end->ru_nivcsw - start->ru_nivcsw;
+}
+
+
+
+/*
+internally used
+copy record written by the process executing the test
+if the test did not finish, its duration is measured until now
+*/
+void tric_read_record(struct tric_context *context) {
+    struct tric_record *record = context->record;
+    context->test->assertions = record->assertions;
+    if (record->end.tv_sec == 0 && record->end.tv_nsec == 0) {
+        clock_gettime(CLOCK_MONOTONIC, &record->end);
+    }
+    context->test->duration = tric_seconds(&record->start, &record->end);
+    context->test->stragglers = record->stragglers;
+    context->test->runs = record->runs > 0 ? record->runs : 1;
+    context->test->failed_runs = record->failed_runs;
+    context->test->frames = record->frames;
+    memcpy(context->test->backtrace, record->backtrace, record->frames * sizeof(void *));
+    if (record->origin != NULL) {
+        /* the code of a spawned process is at another address, the backtrace can not be resolved */
+        const char *origin = (const char *)tric_data()->suite;
+        record->file = record->file ? origin + (record->file - record->origin) : NULL;
+        context->test->frames = 0;
+    }
+    tric_read_usage(context->test, &record->start_usage, &record->end_usage);
+}
+
+
+
+/*
+internally used
+function to hold global execution settings
+*/
+struct tric_settings *tric_settings(void) {
+    static struct tric_settings settings = { .execution = TRIC_EXECUTE_FORK, .timeout = 0, .backtrace = false, .core_dump = false, .repeat = 1, .retries = 0, .filter = NULL, .tests = NULL, .tags = NULL, .shard_count = 1, .shard_index = 0, .history = NULL, .failed_first = false, .rerun_failed = false, .max_failures = 0, .time_budget = 0, .jobs = 1 };
+    return &settings;
+}
+
+
+
+/*
+internally used
+determine how the current test is executed
+*/
+enum tric_execution tric_test_execution(struct tric_context *context) {
+    enum tric_execution execution = context->test->options.execution;
+    if (execution == TRIC_EXECUTE_DEFAULT) {
+        execution = tric_settings()->execution;
+    }
+    /* tests created for each case of a table can not jump back into the loop creating them */
+    if (execution == TRIC_EXECUTE_INLINE && context->test->cases > 0) {
+        return TRIC_EXECUTE_FORK;
+    }
+    return execution;
+}
+
+
+
+/*
+internally used
+determine timeout of the current test in seconds, 0 if the test has no timeout
+*/
+double tric_test_timeout(struct tric_context *context) {
+    if (context->test->options.timeout > 0) {
+        return context->test->options.timeout;
+    }
+    return tric_settings()->timeout;
+}
+
+
+
+/*
+internally used
+determine how often the current test must pass
+*/
+size_t tric_test_repeat(struct tric_context *context) {
+    if (context->test->options.repeat > 0) {
+        return context->test->options.repeat;
+    }
+    return tric_settings()->repeat;
+}
+
+
+
+/*
+internally used
+determine how often a failing run of the current test is executed again
+*/
+size_t tric_test_retries(struct tric_context *context) {
+    if (context->test->options.retries > 0) {
+        return context->test->options.retries;
+    }
+    return tric_settings()->retries;
+}
+
+
+
+/*
+internally used
+check if the current test is executed several times
+*/
+bool tric_has_runs(struct tric_context *context) {
+    return tric_test_repeat(context) > 1 || tric_test_retries(context) > 0;
+}
+
+
+
+/*
+internally used
+check if the ID is contained in a comma separated list of IDs and ranges of IDs (e.g. "3,7-9,12-")
+invalid entries of the list are ignored
+*/
+bool tric_selected_id(const char *tests, size_t id) {
+    const char *position = tests;
+    while (*position != '\0') {
+        char *end;
+        size_t first = strtoul(position, &end, 10);
+        size_t last = first;
+        bool valid = end != position;
+        if (valid && *end == '-') {
+            position = end + 1;
+            last = strtoul(position, &end, 10);
+            if (end == position) {
+                last = (size_t)-1;
+            }
+        }
+        if (valid && (*end == ',' || *end == '\0') && first <= id && id <= last) {
+            return true;
+        }
+        position = strchr(end, ',');
+        if (position == NULL) {
+            return false;
+        }
+        position++;
+    }
+    return false;
+}
+
+
+
+/*
+internally used
+check if a comma separated list of tags contains the tag with the given length, spaces around the tags are ignored
+*/
+bool tric_has_tag(const char *tags, const char *tag, size_t length) {
+    if (tags == NULL) {
+        return false;
+    }
+    while (*tags != '\0') {
+        while (*tags == ' ') {
+            tags++;
+        }
+        size_t tag_length = strcspn(tags, ",");
+        const char *next = tags + tag_length;
+        while (tag_length > 0 && tags[tag_length - 1] == ' ') {
+            tag_length--;
+        }
+        if (tag_length == length && strncmp(tags, tag, length) == 0) {
+            return true;
+        }
+        tags = *next == ',' ? next + 1 : next;
+    }
+    return false;
+}
+
+
+
+/*
+internally used
+check if tags are selected by a comma separated list of tags to include and tags to exclude (prefixed with "!")
+the tags must contain none of the excluded tags and one of the included tags if there are any
+*/
+bool tric_selected_tags(const char *selection, const char *tags) {
+    bool includes = false;
+    bool included = false;
+    while (*selection != '\0') {
+        while (*selection == ' ') {
+            selection++;
+        }
+        size_t length = strcspn(selection, ",");
+        const char *next = selection + length;
+        while (length > 0 && selection[length - 1] == ' ') {
+            length--;
+        }
+        if (length > 1 && *selection == '!') {
+            if (tric_has_tag(tags, selection + 1, length - 1)) {
+                return false;
+            }
+        } else if (length > 0) {
+            includes = true;
+            included = included || tric_has_tag(tags, selection, length);
+        }
+        selection = *next == ',' ? next + 1 : next;
+    }
+    return includes == false || included;
+}
+
+
+
+/*
+internally used
+check if a result of a previous run is a failure
+*/
+bool tric_failed_result(enum tric_result result) {
+    return result == TRIC_FAILURE || result == TRIC_CRASHED || result == TRIC_TIMEOUT || result == TRIC_EXCEEDED;
+}
+
+
+
+/*
+internally used
+check if the current test is selected by the environment variables TRIC_FILTER, TRIC_TESTS, TRIC_TAGS and TRIC_RERUN_FAILED
+tests without a result in the history are new and are executed as well when only the failed tests are executed again
+*/
+bool tric_is_selected(struct tric_context *context) {
+    const struct tric_settings *settings = tric_settings();
+    if (settings->rerun_failed && context->test->previous_result != TRIC_UNDEFINED && tric_failed_result(context->test->previous_result) == false) {
+        return false;
+    }
+    if (settings->filter != NULL && fnmatch(settings->filter, context->test->description, 0) != 0) {
+        return false;
+    }
+    if (settings->tags != NULL && tric_selected_tags(settings->tags, context->test->options.tags) == false) {
+        return false;
+    }
+    return settings->tests == NULL || tric_selected_id(settings->tests, context->test->id);
+}
+
+
+
+/*
+internally used
+check if the current test belongs to the shard executed
+*/
+bool tric_in_shard(struct tric_context *context) {
+    const struct tric_settings *settings = tric_settings();
+    return settings->shard_count <= 1 || context->test->shard == settings->shard_index;
+}
+
+
+
+/*
+internally used
+check if the current test is deferred to a later run, either by the selection of the tests fitting into the time budget or since the remaining time is too short for its previous duration
+*/
+bool tric_deferred(struct tric_context *context) {
+    double budget = tric_settings()->time_budget;
+    if (budget <= 0) {
+        return false;
+    }
+    if (context->test->deferred) {
+        return true;
+    }
+    if (context->test->over_budget) {
+        return false;
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double duration = context->test->previous_duration > 0 ? context->test->previous_duration : 0;
+    return tric_seconds(&context->start, &now) + duration > budget;
+}
+
+
+
+/*
+internally used
+function to hold the context of the test executed in the process of the test suite
+*/
+struct tric_context *tric_inline_context(bool set, struct tric_context *context) {
+    static struct tric_context *current = NULL;
+    if (set) {
+        current = context;
+    }
+    return current;
+}
+
+
+
+/*
+internally used
+check if the current test is executed in the process of the test suite
+*/
+bool tric_is_inline(struct tric_context *context) {
+    return tric_inline_context(false, NULL) == context;
+}
+
+
+
+/*
+internally used
+terminate test due to failing assert
+*/
+void tric_fail(struct tric_context *context, const char *file, size_t line) {
+    context->record->line = line;
+    context->record->file = file;
+    tric_end_record(context);
+    if (tric_is_inline(context)) {
+        context->inline_test.status = EXIT_TEST_FAILURE;
+        siglongjmp(context->inline_test.jump, 1);
+    }
+    _exit(EXIT_TEST_FAILURE);
+}
+
+
+
+/*
+internally used
+mark test as successful
+*/
+void tric_status_ok(struct tric_context *context, bool before, bool after) {
+    context->test->before = before ? TRIC_OK : TRIC_UNDEFINED;
+    context->test->result = TRIC_OK;
+    context->test->after = after ? TRIC_OK : TRIC_UNDEFINED;
+}
+
+
+
+/*
+internally used
+mark test as failed
+*/
+void tric_status_fail(struct tric_context *context, bool before, bool after) {
+    context->suite->failed_tests++;
+    context->test->line = context->record->line;
+    context->test->file = context->record->file;
+    context->test->before = before ? TRIC_OK : TRIC_UNDEFINED;
+    context->test->result = TRIC_FAILURE;
+    context->test->after = after ? TRIC_SKIPPED : TRIC_UNDEFINED;
+}
+
+
+
+/*
+internally used
+mark test as failed in before function
+*/
+void tric_status_fail_before(struct tric_context *context, bool before, bool after) {
+    context->suite->failed_tests++;
+    context->test->before = TRIC_FAILURE;
+    context->test->result = TRIC_SKIPPED;
+    context->test->after = after ? TRIC_SKIPPED : TRIC_UNDEFINED;
+}
+
+
+
+/*
+internally used
+mark test as failed in after function
+*/
+void tric_status_fail_after(struct tric_context *context, bool before, bool after) {
+    context->test->before = before ? TRIC_OK : TRIC_UNDEFINED;
+    context->test->result = TRIC_OK;
+    context->test->after = TRIC_FAILURE;
+}
+
+
+
+/*
+internally used
+mark test as failed due to signal
+*/
+void tric_status_crash(struct tric_context *context, bool before, bool after) {
+    context->suite->failed_tests++;
+    context->test->before = before ? TRIC_CRASHED : TRIC_UNDEFINED;
+    context->test->result = TRIC_CRASHED;
+    context->test->after = after ? TRIC_CRASHED : TRIC_UNDEFINED;
+}
+
+
+
+/*
+internally used
+mark test as failed due to timeout
+*/
+void tric_status_timeout(struct tric_context *context, bool before, bool after) {
+    context->suite->failed_tests++;
+    context->test->before = before ? TRIC_TIMEOUT : TRIC_UNDEFINED;
+    context->test->result = TRIC_TIMEOUT;
+    context->test->after = after ? TRIC_TIMEOUT : TRIC_UNDEFINED;
+}
+
+
+
+/*
+internally used
+mark test as failed due to exceeded resource limit
+*/
+void tric_status_exceeded(struct tric_context *context, bool before, bool after) {
+    context->suite->failed_tests++;
+    context->test->before = before ? TRIC_EXCEEDED : TRIC_UNDEFINED;
+    context->test->result = TRIC_EXCEEDED;
+    context->test->after = after ? TRIC_EXCEEDED : TRIC_UNDEFINED;
+}
+
+
+
+/*
+internally used
+mark test as failed due to fork error
+*/
+void tric_status_fail_fork(struct tric_context *context, bool before, bool after) {
+    context->suite->skipped_tests++;
+    context->test->before = TRIC_UNDEFINED;
+    context->test->result = TRIC_UNDEFINED;
+    context->test->after = TRIC_UNDEFINED;
+}
+
+
+
+/*
+internally used
+mark test as not executed since its process could not start the test, e.g. a spawned process that did not find the test
+the test was already counted as executed when its process was started
+*/
+void tric_status_not_started(struct tric_context *context, bool before, bool after) {
+    context->suite->executed_tests--;
+    tric_status_fail_fork(context, before, after);
+}
+
+
+
+/*
+internally used
+mark test as skipped
+*/
+void tric_status_skip(struct tric_context *context, bool before, bool after) {
+    context->suite->skipped_tests++;
+    context->test->before = before ? TRIC_SKIPPED : TRIC_UNDEFINED;
+    context->test->result = TRIC_SKIPPED;
+    context->test->after = after ? TRIC_SKIPPED : TRIC_UNDEFINED;
+}
+
+
+
+/*
+internally used
+mark test as not executed since it belongs to another shard
+*/
+void tric_status_not_in_shard(struct tric_context *context, bool before, bool after) {
+    context->suite->not_in_shard_tests++;
+    context->test->before = TRIC_UNDEFINED;
+    context->test->result = TRIC_NOT_IN_SHARD;
+    context->test->after = TRIC_UNDEFINED;
+}
+
+
+
+/*
+internally used
+mark test as not executed since the test suite was stopped after too many failures
+*/
+void tric_status_not_run(struct tric_context *context, bool before, bool after) {
+    context->suite->not_run_tests++;
+    context->test->before = TRIC_UNDEFINED;
+    context->test->result = TRIC_NOT_RUN;
+    context->test->after = TRIC_UNDEFINED;
+}
+
+
+
+/*
+internally used
+mark test as deferred to a later run since it does not fit into the time budget
+*/
+void tric_status_deferred(struct tric_context *context, bool before, bool after) {
+    context->suite->deferred_tests++;
+    context->test->before = TRIC_UNDEFINED;
+    context->test->result = TRIC_DEFERRED;
+    context->test->after = TRIC_UNDEFINED;
+}
+
+
+
+/*
+internally used
+mark test according to exit status
+*/
+void tric_set_status(struct tric_context *context, enum tric_exit status, bool before, bool after) {
+    static const tric_status_t states[] = {
+        [EXIT_OK] = tric_status_ok,
+        [EXIT_TEST_FAILURE] = tric_status_fail,
+        [EXIT_BEFORE_FAILURE] = tric_status_fail_before,
+        [EXIT_AFTER_FAILURE] = tric_status_fail_after,
+        [EXIT_SIGNAL] = tric_status_crash,
+        [EXIT_FORK] = tric_status_fail_fork,
+        [EXIT_SKIP] = tric_status_skip,
+        [EXIT_TIMEOUT] = tric_status_timeout,
+        [EXIT_EXCEEDED] = tric_status_exceeded,
+        [EXIT_NOT_IN_SHARD] = tric_status_not_in_shard,
+        [EXIT_NOT_RUN] = tric_status_not_run,
+        [EXIT_DEFERRED] = tric_status_deferred,
+        [EXIT_NOT_STARTED] = tric_status_not_started
+    };
+    states[status](context, before, after);
+}
+
+
+
+/*
+internally used
+check if resource limits are set for the test
+*/
+bool tric_has_limits(const struct tric_test *test) {
+    return test->options.memory_limit > 0
+    || test->options.cpu_limit > 0
+    || test->options.file_limit > 0
+    || test->options.output_limit > 0;
+}
+
+
+
+/*
+internally used
+set soft limit of a resource of the process executing the test
+*/
+void tric_limit(int resource, size_t limit) {
+    struct rlimit current;
+    if (limit == 0 || getrlimit(resource, &current) == -1) {
+        return;
+    }
+    current.rlim_cur = limit < current.rlim_max ? limit : current.rlim_max;
+    setrlimit(resource, &current);
+}
+
+
+
+/*
+internally used
+apply resource limits of the test to the process executing the test
+*/
+void tric_apply_limits(const struct tric_test *test) {
+    tric_limit(RLIMIT_AS, test->options.memory_limit);
+    tric_limit(RLIMIT_CPU, test->options.cpu_limit);
+    tric_limit(RLIMIT_NOFILE, test->options.file_limit);
+    tric_limit(RLIMIT_FSIZE, test->options.output_limit);
+}
+
+
+
+/*
+internally used
+check if a signal that terminated a test was caused by a resource limit of the test
+*/
+bool tric_exceeded(const struct tric_test *test, int signal_number) {
+    switch (signal_number) {
+    case SIGXCPU:
+        return test->options.cpu_limit > 0;
+    case SIGXFSZ:
+        return test->options.output_limit > 0;
+    case SIGKILL:
+    case SIGABRT:
+        return test->options.memory_limit > 0;
+    default:
+        return false;
+    }
+}
+
+
+
+/*
+internally used
+determine exit status of a test from the status of its process
+*/
+enum tric_exit tric_exit_status(const struct tric_test *test, int status, bool timed_out) {
+    if (timed_out) {
+        return EXIT_TIMEOUT;
+    }
+    if (WIFSIGNALED(status) == false) {
+        return WEXITSTATUS(status);
+    }
+    return tric_exceeded(test, WTERMSIG(status)) ? EXIT_EXCEEDED : EXIT_SIGNAL;
+}
+
+
+
+/*
+internally used
+clear record before a test is executed and set the data needed by the process of the test suite
+*/
+void tric_prepare_record(struct tric_context *context, bool before, bool after) {
+    tric_reset_record(context->record);
+    context->record->before = before;
+    context->record->after = after;
+    context->record->timeout = tric_test_timeout(context);
+}
+
+
+
+/*
+internally used
+seconds until the test of the record times out, 0 if the time is over and -1 if the test has no timeout
+*/
+double tric_remaining_time(const struct tric_record *record) {
+    if (record->timeout <= 0) {
+        return -1;
+    }
+    if (record->start.tv_sec == 0 && record->start.tv_nsec == 0) {
+        return record->timeout;
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double remaining = record->timeout - tric_seconds(&record->start, &now);
+    return remaining > 0 ? remaining : 0;
+}
+
+
+
+/*
+internally used
+open file descriptor to wait for a process with poll, -1 if not supported
+*/
+int tric_open_process(pid_t pid) {
+#ifdef SYS_pidfd_open
+    return syscall(SYS_pidfd_open, pid, 0);
+#else
+    return -1;
+#endif
+}
+
+
+
+/*
+internally used
+wait until one of the processes terminated or the given number of seconds passed
+*/
+void tric_wait_processes(struct pollfd *processes, size_t number_of_processes, double seconds) {
+    size_t i;
+    for (i = 0; i < number_of_processes; i++) {
+        if (processes[i].fd < 0) {
+            break;
+        }
+    }
+    if (number_of_processes == 0 || i < number_of_processes) {
+        seconds = seconds < TRIC_POLL_TIME ? seconds : TRIC_POLL_TIME;
+        struct timespec pause = { .tv_sec = 0, .tv_nsec = seconds * 1e9 };
+        nanosleep(&pause, NULL);
+        return;
+    }
+    poll(processes, number_of_processes, seconds * 1000 + 1);
+}
+
+
+
+/*
+internally used
+print backtrace of a test that timed out
+*/
+void tric_print_backtrace(int signal_number) {
+    static const char message[] = "backtrace of test that timed out:\n";
+    write(STDERR_FILENO, message, sizeof(message) - 1);
+#ifdef __GLIBC__
+    void *frames[64];
+    backtrace_symbols_fd(frames, backtrace(frames, 64), STDERR_FILENO);
+#endif
+}
+
+
+
+/*
+internally used
+record backtrace of a crashing test and terminate the process by the signal with its default action
+*/
+void tric_crash(int signal_number) {
+    struct tric_record *record = tric_crash_record(false, NULL);
+    if (record != NULL) {
+        tric_record_backtrace(record);
+    }
+    signal(signal_number, SIG_DFL);
+    raise(signal_number);
+}
+
+
+
+/*
+internally used
+install signal handlers to record the backtrace of a crashing test
+the handlers run on an alternate stack to record stack overflows as well
+*/
+void tric_catch_crashes(void) {
+    static char stack[65536];
+#ifdef __GLIBC__
+    /* backtrace() may allocate memory when called for the first time, which is not possible in a signal handler */
+    void *frame;
+    backtrace(&frame, 1);
+#endif
+    stack_t alternate = { .ss_sp = stack, .ss_size = sizeof(stack), .ss_flags = 0 };
+    sigaltstack(&alternate, NULL);
+    struct sigaction action = { .sa_handler = tric_crash, .sa_flags = SA_ONSTACK };
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGSEGV, &action, NULL);
+    sigaction(SIGFPE, &action, NULL);
+    sigaction(SIGBUS, &action, NULL);
+    sigaction(SIGILL, &action, NULL);
+    sigaction(SIGABRT, &action, NULL);
+}
+
+
+
+/*
+internally used
+disable core dumps of the test process unless they are allowed for the test
+the inherited limit is restored for tests executed later in the same process
+*/
+void tric_limit_core(const struct tric_test *test) {
+    static struct rlimit inherited;
+    static bool read = false;
+    if (read == false) {
+        read = getrlimit(RLIMIT_CORE, &inherited) == 0;
+        if (read == false) {
+            return;
+        }
+    }
+    struct rlimit limit = inherited;
+    if (test->options.core_dump == false && tric_settings()->core_dump == false) {
+        limit.rlim_cur = 0;
+    }
+    setrlimit(RLIMIT_CORE, &limit);
+}
+
+
+
+/*
+internally used
+execute the runs of a test that is executed several times in processes forked from the process of the test
+the process of the test stays at the start of the test and returns only in the processes executing the runs
+it terminates with the status of the last run
+*/
+void tric_run_repeated(struct tric_context *context) {
+    if (tric_has_runs(context) == false) {
+        return;
+    }
+    size_t repeat = tric_test_repeat(context);
+    size_t retries = tric_test_retries(context);
+    struct tric_record *record = context->record;
+    size_t passed = 0;
+    int status;
+    while (true) {
+        record->runs++;
+        record->line = 0;
+        record->file = NULL;
+        record->assertions = 0;
+        record->frames = 0;
+        record->end = (struct timespec){ 0 };
+        pid_t child = fork();
+        if (child == 0) {
+            return;
+        }
+        if (child == -1) {
+            /* the test was counted as executed, so a run that can not be started is a failed run */
+            if (++record->failed_runs > retries) {
+                _exit(EXIT_TEST_FAILURE);
+            }
+            continue;
+        }
+        waitpid(child, &status, 0);
+        if (WIFEXITED(status) && WEXITSTATUS(status) == EXIT_OK) {
+            if (++passed >= repeat) {
+                break;
+            }
+        } else if (++record->failed_runs > retries) {
+            break;
+        }
+    }
+    if (WIFSIGNALED(status)) {
+        signal(WTERMSIG(status), SIG_DFL);
+        raise(WTERMSIG(status));
+    }
+    _exit(WEXITSTATUS(status));
+}
+
+
+
+/*
+internally used
+prepare the process executing a test
+the process gets its own process group to terminate it with all processes it started
+*/
+void tric_start_process(struct tric_context *context) {
+    setpgid(0, 0);
+    tric_apply_limits(context->test);
+    tric_limit_core(context->test);
+#ifdef __linux__
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    if (context->batch.child) {
+        prctl(PR_SET_CHILD_SUBREAPER, 1);
+    }
+#endif
+    if (tric_settings()->backtrace) {
+        signal(TRIC_BACKTRACE_SIGNAL, tric_print_backtrace);
+        tric_catch_crashes();
+    }
+    tric_start_record(context);
+    tric_run_repeated(context);
+}
+
+
+
+/*
+internally used
+terminate the process group of a test that timed out
+*/
+void tric_kill_test(pid_t pid) {
+    if (tric_settings()->backtrace && kill(pid, TRIC_BACKTRACE_SIGNAL) == 0) {
+        struct timespec pause = { .tv_sec = 0, .tv_nsec = TRIC_BACKTRACE_TIME * 1e9 };
+        nanosleep(&pause, NULL);
+    }
+    kill(-pid, SIGKILL);
+    kill(pid, SIGKILL);
+}
+
+
+
+/*
+internally used
+kill and reap the processes left in the process group of a finished test
+return the number of processes that were still running
+*/
+size_t tric_reap_group(pid_t group) {
+    if (kill(-group, SIGKILL) == -1) {
+        return 0;
+    }
+    size_t stragglers = 0;
+    int status;
+    while (waitpid(-group, &status, 0) > 0) {
+        if (WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL) {
+            stragglers++;
+        }
+    }
+    return stragglers;
+}
+
+
+
+/*
+internally used
+check if the process has child processes that were not waited for
+*/
+bool tric_has_children(void) {
+    siginfo_t info;
+    return waitid(P_ALL, 0, &info, WEXITED | WNOHANG | WNOWAIT) == 0;
+}
+
+
+
+/*
+internally used
+check if the test suite was stopped after too many failures, then no further tests are executed
+*/
+bool tric_stopped(const struct tric_context *context) {
+    size_t max_failures = tric_settings()->max_failures;
+    return max_failures > 0 && context->suite->failed_tests >= max_failures;
+}
+
+
+
+/*
+internally used
+terminate running tests whose time is over and wait until a test terminated or the next test times out
+*/
+void tric_supervise_jobs(struct tric_context *context) {
+    struct tric_queue *queue = context->queue;
+    struct pollfd processes[queue->jobs];
+    size_t number_of_processes = 0;
+    double remaining = -1;
+    size_t i;
+    for (i = 0; i < queue->length; i++) {
+        struct tric_job *job = &queue->entries[(queue->head + i) % queue->capacity];
+        /* held tests wait for their start without a timeout */
+        if (job->finished || job->held || number_of_processes >= queue->jobs) {
+            continue;
+        }
+        processes[number_of_processes++] = (struct pollfd){ .fd = job->pidfd, .events = POLLIN };
+        if (job->timed_out) {
+            continue;
+        }
+        double job_remaining = tric_remaining_time(job->record);
+        if (job_remaining == 0) {
+            tric_kill_test(job->pid);
+            job->timed_out = true;
+            return;
+        }
+        if (job_remaining > 0 && (remaining < 0 || job_remaining < remaining)) {
+            remaining = job_remaining;
+        }
+    }
+    if (remaining < 0) {
+        siginfo_t info;
+        waitid(P_ALL, 0, &info, WEXITED | WNOWAIT);
+        return;
+    }
+    tric_wait_processes(processes, number_of_processes, remaining);
+}
+
+
+
+/*
+internally used
+report finished tests in the order they were reached in the test suite
+*/
+void tric_report_jobs(struct tric_context *context) {
+    struct tric_queue *queue = context->queue;
+    while (queue->length > 0 && queue->entries[queue->head].finished) {
+        tric_report()->test(context->suite, queue->entries[queue->head].test, tric_report()->data);
+        queue->head = (queue->head + 1) % queue->capacity;
+        queue->length--;
+    }
+}
+
+
+
+/*
+internally used
+mark test in queue according to exit status
+*/
+void tric_set_job_status(struct tric_context *context, struct tric_job *job, enum tric_exit status) {
+    struct tric_test *current_test = context->test;
+    struct tric_record *current_record = context->record;
+    context->test = job->test;
+    context->record = job->record;
+    if (job->record) {
+        tric_read_record(context);
+        job->record->used = false;
+    }
+    tric_set_status(context, status, job->before, job->after);
+    context->test = current_test;
+    context->record = current_record;
+    job->finished = true;
+}
+
+
+
+/*
+internally used
+find running test by process id
+*/
+struct tric_job *tric_find_job(struct tric_queue *queue, pid_t pid) {
+    size_t i;
+    for (i = 0; i < queue->length; i++) {
+        struct tric_job *job = &queue->entries[(queue->head + i) % queue->capacity];
+        if (job->finished == false && job->pid == pid) {
+            return job;
+        }
+    }
+    return NULL;
+}
+
+
+
+/*
+internally used
+mark all running tests as crashed if their processes can not be waited for anymore
+*/
+void tric_lose_jobs(struct tric_context *context) {
+    struct tric_queue *queue = context->queue;
+    size_t i;
+    for (i = 0; i < queue->length; i++) {
+        struct tric_job *job = &queue->entries[(queue->head + i) % queue->capacity];
+        if (job->finished == false) {
+            if (job->pidfd >= 0) {
+                close(job->pidfd);
+            }
+            if (job->release >= 0) {
+                close(job->release);
+            }
+            tric_set_job_status(context, job, EXIT_SIGNAL);
+        }
+    }
+    queue->running = 0;
+    queue->held = 0;
+}
+
+
+
+/*
+internally used
+report a held test with the given status instead of starting it
+the process of a forked test is terminated and the test is reported when the process was waited for
+*/
+void tric_drop_job(struct tric_context *context, struct tric_job *job, enum tric_exit status) {
+    if (job->pid > 0) {
+        kill(-job->pid, SIGKILL);
+        kill(job->pid, SIGKILL);
+        job->cancelled = true;
+        job->deferred = status == EXIT_DEFERRED;
+        return;
+    }
+    job->held = false;
+    context->queue->held--;
+    job->record->used = false;
+    job->record = NULL;
+    tric_set_job_status(context, job, status);
+}
+
+
+
+/*
+internally used
+terminate all tests running in parallel or held if the test suite was stopped after too many failures
+*/
+void tric_cancel_jobs(struct tric_context *context) {
+    struct tric_queue *queue = context->queue;
+    if (queue == NULL || tric_stopped(context) == false) {
+        return;
+    }
+    size_t i;
+    for (i = 0; i < queue->length; i++) {
+        struct tric_job *job = &queue->entries[(queue->head + i) % queue->capacity];
+        if (job->finished || job->cancelled) {
+            continue;
+        }
+        if (job->held) {
+            tric_drop_job(context, job, EXIT_NOT_RUN);
+        } else if (job->pid > 0) {
+            kill(-job->pid, SIGKILL);
+            kill(job->pid, SIGKILL);
+            job->cancelled = true;
+        }
+    }
+}
+
+
+
+/*
+internally used
+wait for any test running in parallel to finish
+*/
+void tric_wait_job(struct tric_context *context) {
+    struct tric_queue *queue = context->queue;
+    int status;
+    struct rusage usage;
+    pid_t child;
+    while ((child = wait4(-1, &status, WNOHANG, &usage)) == 0) {
+        tric_supervise_jobs(context);
+    }
+    if (child == -1) {
+        if (errno != EINTR) {
+            tric_lose_jobs(context);
+            tric_report_jobs(context);
+        }
+        return;
+    }
+    struct tric_job *job = tric_find_job(queue, child);
+    if (job == NULL) {
+        return;
+    }
+    bool started = job->held == false;
+    if (started) {
+        queue->running--;
+    } else {
+        job->held = false;
+        queue->held--;
+        close(job->release);
+        job->release = -1;
+    }
+    job->record->end_usage = usage;
+    /* processes killed together with a test that timed out were not left by the test */
+    size_t stragglers = tric_reap_group(child);
+    job->record->stragglers = job->timed_out ? 0 : stragglers;
+    if (job->pidfd >= 0) {
+        close(job->pidfd);
+    }
+    if (job->cancelled && started) {
+        /* the test was started but is reported as not executed */
+        context->suite->executed_tests--;
+        tric_set_job_status(context, job, EXIT_NOT_RUN);
+    } else if (job->cancelled) {
+        /* the record of a held test was never written */
+        job->record->used = false;
+        job->record = NULL;
+        tric_set_job_status(context, job, job->deferred ? EXIT_DEFERRED : EXIT_NOT_RUN);
+    } else {
+        /* a held test whose process terminated by itself is reported like a started test */
+        context->suite->executed_tests += started ? 0 : 1;
+        tric_set_job_status(context, job, tric_exit_status(job->test, status, job->timed_out));
+    }
+    if (WIFSIGNALED(status) && job->timed_out == false && job->cancelled == false) {
+        job->test->signal = WTERMSIG(status);
+    }
+    tric_cancel_jobs(context);
+    tric_report_jobs(context);
+}
+
+
+
+/*
+internally used
+start a new process of the test suite that executes only the current test and writes to the current record
+*/
+pid_t tric_spawn_test(struct tric_context *context) {
+    size_t length = 0;
+    while (environ[length] != NULL) {
+        length++;
+    }
+    char **environment = malloc((length + 2) * sizeof(char *));
+    if (environment == NULL) {
+        return -1;
+    }
+    char variable[sizeof(TRIC_TEST_ID) + 64];
+    snprintf(variable, sizeof(variable), "%s=%zu:%d:%zu", TRIC_TEST_ID, context->test->id, context->records_file, (size_t)(context->record - context->records));
+    size_t i;
+    size_t j = 0;
+    for (i = 0; i < length; i++) {
+        if (strncmp(environ[i], TRIC_TEST_ID "=", sizeof(TRIC_TEST_ID)) != 0) {
+            environment[j++] = environ[i];
+        }
+    }
+    environment[j++] = variable;
+    environment[j] = NULL;
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP);
+    posix_spawnattr_setpgroup(&attributes, 0);
+    char *arguments[] = { TRIC_SPAWN_PATH, NULL };
+    pid_t child;
+    int error = posix_spawn(&child, TRIC_SPAWN_PATH, NULL, &attributes, arguments, environment);
+    posix_spawnattr_destroy(&attributes);
+    free(environment);
+    return error == 0 ? child : -1;
+}
+
+
+
+/*
+internally used
+start the process executing the current test
+return 0 in the process if it was forked
+*/
+pid_t tric_fork_test(struct tric_context *context) {
+    if (tric_test_execution(context) == TRIC_EXECUTE_SPAWN && context->records_file >= 0) {
+        return tric_spawn_test(context);
+    }
+    return fork();
+}
+
+
+
+/*
+internally used
+start a held test, its forked process continues when the write end of its pipe is closed and a spawned test gets its process only now
+the test is deferred instead if the time budget was used up while it was held
+*/
+void tric_release_job(struct tric_context *context, struct tric_job *job) {
+    struct tric_queue *queue = context->queue;
+    struct tric_test *current_test = context->test;
+    struct tric_record *current_record = context->record;
+    context->test = job->test;
+    context->record = job->record;
+    bool deferred = tric_deferred(context);
+    pid_t child = job->pid == 0 && deferred == false ? tric_spawn_test(context) : job->pid;
+    context->test = current_test;
+    context->record = current_record;
+    if (deferred || child == -1) {
+        tric_drop_job(context, job, deferred ? EXIT_DEFERRED : EXIT_FORK);
+        tric_report_jobs(context);
+        return;
+    }
+    if (job->pid == 0) {
+        setpgid(child, child);
+        job->pid = child;
+        job->pidfd = tric_open_process(child);
+    } else {
+        close(job->release);
+        job->release = -1;
+    }
+    job->held = false;
+    queue->held--;
+    queue->running++;
+    context->suite->executed_tests++;
+}
+
+
+
+/*
+internally used
+start the held test with the lowest rank if fewer tests than jobs are running, otherwise wait for a running test to finish
+*/
+void tric_advance_jobs(struct tric_context *context) {
+    struct tric_queue *queue = context->queue;
+    struct tric_job *next = NULL;
+    size_t i;
+    for (i = 0; i < queue->length && queue->running < queue->jobs; i++) {
+        struct tric_job *job = &queue->entries[(queue->head + i) % queue->capacity];
+        if (job->held && job->cancelled == false && (next == NULL || queue->ranks[job->test->id - 1] < queue->ranks[next->test->id - 1])) {
+            next = job;
+        }
+    }
+    if (next == NULL) {
+        tric_wait_job(context);
+        return;
+    }
+    tric_release_job(context, next);
+}
+
+
+
+/*
+internally used
+wait until another test can be started and add it to the queue
+*/
+struct tric_job *tric_enqueue_job(struct tric_context *context, bool before, bool after) {
+    struct tric_queue *queue = context->queue;
+    /* with a schedule, tests are held until a job is free */
+    while ((queue->ranks == NULL && queue->running >= queue->jobs) || queue->length >= queue->capacity) {
+        tric_advance_jobs(context);
+    }
+    struct tric_job *job = &queue->entries[(queue->head + queue->length) % queue->capacity];
+    *job = (struct tric_job){ .test = context->test, .record = NULL, .pid = 0, .pidfd = -1, .before = before, .after = after, .finished = false, .timed_out = false, .cancelled = false, .held = false, .release = -1, .deferred = false };
+    queue->length++;
+    return job;
+}
+
+
+
+/*
+internally used
+wait until all tests running in parallel or held are finished and reported
+*/
+void tric_finish_jobs(struct tric_context *context) {
+    if (context->queue == NULL) {
+        return;
+    }
+    while (context->queue->running > 0 || context->queue->held > 0) {
+        tric_advance_jobs(context);
+    }
+    tric_report_jobs(context);
+}
+
+
+
+/*
+internally used
+wait in the forked process of a held test until the test is started
+the write ends of the pipes of the other held tests are closed, otherwise these tests could not be started
+*/
+void tric_wait_release(struct tric_context *context, int release, pid_t parent) {
+    struct tric_queue *queue = context->queue;
+    size_t i;
+    for (i = 0; i < queue->length; i++) {
+        struct tric_job *job = &queue->entries[(queue->head + i) % queue->capacity];
+        if (job->release >= 0) {
+            close(job->release);
+        }
+    }
+#ifdef __linux__
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+    char byte;
+    while (read(release, &byte, 1) == -1 && errno == EINTR) {
+        continue;
+    }
+    close(release);
+    /* the pipe is closed as well if the process of the test suite terminated */
+    if (getppid() != parent) {
+        _exit(EXIT_NOT_RUN);
+    }
+}
+
+
+
+/*
+internally used
+add the current test to the queue and fork its process, which waits until the test is started in the order of the ranks
+the test is forked at its position in the test suite, so it sees the same data as if it was started there
+*/
+void tric_hold_test(struct tric_context *context, bool before, bool after) {
+    struct tric_queue *queue = context->queue;
+    /* each held test keeps its record */
+    while (queue->held + queue->running >= context->number_of_records) {
+        tric_advance_jobs(context);
+    }
+    struct tric_job *job = tric_enqueue_job(context, before, after);
+    context->record = tric_unused_record(context);
+    tric_prepare_record(context, before, after);
+    job->record = context->record;
+    job->held = true;
+    queue->held++;
+    /* a spawned test executes the test suite itself, so it has no process until it is started */
+    if (tric_test_execution(context) == TRIC_EXECUTE_SPAWN && context->records_file >= 0) {
+        context->mode = MODE_RESET;
+        return;
+    }
+    int release[2];
+    if (pipe(release) == -1) {
+        context->mode = MODE_RESET;
+        tric_drop_job(context, job, EXIT_FORK);
+        tric_report_jobs(context);
+        return;
+    }
+    fcntl(release[0], F_SETFD, FD_CLOEXEC);
+    fcntl(release[1], F_SETFD, FD_CLOEXEC);
+    pid_t parent = getpid();
+    pid_t child = fork();
+    if (child == 0) {
+        close(release[1]);
+        tric_wait_release(context, release[0], parent);
+        tric_start_process(context);
+        return;
+    }
+    close(release[0]);
+    context->mode = MODE_RESET;
+    if (child == -1) {
+        close(release[1]);
+        tric_drop_job(context, job, EXIT_FORK);
+        tric_report_jobs(context);
+        return;
+    }
+    setpgid(child, child);
+    job->pid = child;
+    job->pidfd = tric_open_process(child);
+    job->release = release[1];
+}
+
+
+
+/*
+internally used
+execute the test with the ID passed to a spawned process and skip all other tests
+*/
+void tric_run_spawned_test(struct tric_context *context) {
+    if (context->test->id != context->spawned) {
+        context->mode = MODE_RESET;
+        return;
+    }
+    tric_start_process(context);
+    context->record->origin = (const char *)tric_data()->suite;
+}
+
+
+
+/*
+internally used
+execute test in separate process without waiting for it to finish
+*/
+void tric_queue_test(struct tric_context *context, bool before, bool after) {
+    if (context->queue->ranks != NULL) {
+        tric_hold_test(context, before, after);
+        return;
+    }
+    struct tric_job *job = tric_enqueue_job(context, before, after);
+    context->record = tric_unused_record(context);
+    tric_prepare_record(context, before, after);
+    pid_t child = tric_fork_test(context);
+    if (child == 0) {
+        tric_start_process(context);
+        return;
+    }
+    context->mode = MODE_RESET;
+    if (child == -1) {
+        context->record->used = false;
+        tric_set_job_status(context, job, EXIT_FORK);
+    } else {
+        context->suite->executed_tests++;
+        setpgid(child, child);
+        job->pid = child;
+        job->pidfd = tric_open_process(child);
+        job->record = context->record;
+        context->queue->running++;
+    }
+    tric_report_jobs(context);
+}
+
+
+
+/*
+internally used
+terminate test executed in the process of the test suite due to a signal
+if no such test is executed, the signal is raised again with its default action
+*/
+void tric_catch_signal(int signal_number) {
+    struct tric_context *context = tric_inline_context(false, NULL);
+    if (context == NULL) {
+        signal(signal_number, SIG_DFL);
+        raise(signal_number);
+        return;
+    }
+    context->inline_test.status = EXIT_SIGNAL;
+    context->inline_test.signal = signal_number;
+    if (tric_settings()->backtrace) {
+        tric_record_backtrace(context->record);
+    }
+    siglongjmp(context->inline_test.jump, 1);
+}
+
+
+
+/*
+internally used
+catch signals of crashing tests on an alternate stack
+*/
+void tric_catch_signals(void) {
+    static bool installed = false;
+    static char stack[65536];
+    if (installed) {
+        return;
+    }
+    installed = true;
+    stack_t alternate = { .ss_sp = stack, .ss_size = sizeof(stack), .ss_flags = 0 };
+    sigaltstack(&alternate, NULL);
+    struct sigaction action = { .sa_handler = tric_catch_signal, .sa_flags = SA_ONSTACK };
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGSEGV, &action, NULL);
+    sigaction(SIGFPE, &action, NULL);
+    sigaction(SIGBUS, &action, NULL);
+}
+
+
+
+/*
+internally used
+prepare execution of test in the process of the test suite
+*/
+void tric_start_inline(struct tric_context *context, bool before, bool after) {
+    tric_catch_signals();
+    context->suite->executed_tests++;
+    context->inline_test.before = before;
+    context->inline_test.after = after;
+    context->inline_test.signal = 0;
+    context->inline_test.shared = context->record;
+    context->record = &context->inline_test.record;
+    tric_reset_record(context->record);
+    tric_start_record(context);
+    tric_inline_context(true, context);
+}
+
+
+
+/*
+internally used
+mark test executed in the process of the test suite according to exit status
+*/
+void tric_finish_inline(struct tric_context *context, enum tric_exit status) {
+    struct tric_inline *test = &context->inline_test;
+    tric_inline_context(true, NULL);
+    getrusage(RUSAGE_SELF, &context->record->end_usage);
+    context->mode = MODE_RESET;
+    if (context->queue) {
+        struct tric_job *job = tric_enqueue_job(context, test->before, test->after);
+        job->record = context->record;
+        tric_set_job_status(context, job, status);
+        job->test->signal = test->signal;
+        tric_cancel_jobs(context);
+        tric_report_jobs(context);
+    } else {
+        tric_read_record(context);
+        tric_set_status(context, status, test->before, test->after);
+        context->test->signal = test->signal;
+        tric_report()->test(context->suite, context->test, tric_report()->data);
+    }
+    context->record = test->shared;
+}
+
+
+
+/*
+internally used
+finish test executed in the process of the test suite after jumping back to the suite function
+*/
+void tric_resume_inline(struct tric_context *context) {
+    tric_finish_inline(context, context->inline_test.status);
+}
+
+
+
+/*
+internally used
+check if the process executing a batch can execute another test
+*/
+bool tric_continue_batch(struct tric_context *context) {
+    struct tric_batch *batch = &context->batch;
+    if (batch->shared) {
+        return batch->length < context->number_of_records && context->test->options.share_before && tric_test_execution(context) == TRIC_EXECUTE_FORK;
+    }
+    if (context->test->options.share_before) {
+        return false;
+    }
+    if (batch->length >= batch->size || tric_test_execution(context) != TRIC_EXECUTE_FORK || tric_has_limits(context->test) || tric_has_runs(context)) {
+        return false;
+    }
+    /* processes left by the previous test are counted for it */
+    if (tric_has_children()) {
+        return false;
+    }
+    if (batch->adaptive == false) {
+        return true;
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return tric_seconds(&batch->start, &now) < TRIC_BATCH_TIME;
+}
+
+
+
+/*
+internally used
+terminate the process executing a batch before code that must run in the process of the test suite
+*/
+void tric_end_batch(struct tric_context *context) {
+    if (context->batch.child) {
+        _exit(EXIT_OK);
+    }
+}
+
+
+
+/*
+internally used
+execute test in the process executing a batch or terminate the batch
+*/
+void tric_run_batch_test(struct tric_context *context, bool before, bool after) {
+    if (tric_continue_batch(context) == false) {
+        _exit(EXIT_OK);
+    }
+    context->batch.length++;
+    /* the records of a batch follow each other */
+    context->record++;
+    tric_prepare_record(context, before, after);
+    if (context->batch.shared) {
+        /* the process of the test is forked after the before function */
+        return;
+    }
+    tric_limit_core(context->test);
+    tric_start_record(context);
+}
+
+
+
+/*
+internally used
+determine number of records that can be used by the process executing a batch or a group of tests sharing a before function
+*/
+size_t tric_batch_records(struct tric_context *context) {
+    return context->batch.shared ? context->number_of_records : context->batch.size;
+}
+
+
+
+/*
+internally used
+check if the current test starts a group of tests sharing a before function
+*/
+bool tric_shares_before(struct tric_context *context, bool before) {
+    return before && context->test->options.share_before && context->number_of_records > 1 && tric_test_execution(context) == TRIC_EXECUTE_FORK;
+}
+
+
+
+/*
+internally used
+prepare the process executing a group of tests sharing a before function
+the process only waits for the processes of the tests, which are prepared like any other test process
+*/
+void tric_start_group(struct tric_context *context) {
+    setpgid(0, 0);
+#ifdef __linux__
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    prctl(PR_SET_CHILD_SUBREAPER, 1);
+#endif
+    context->batch.child = true;
+    context->batch.length = 1;
+    context->batch.before = NULL;
+    context->batch.data = NULL;
+}
+
+
+
+/*
+internally used
+prepare records for the tests executed in the process of a batch
+*/
+void tric_start_batch(struct tric_context *context, bool before, bool after) {
+    size_t i;
+    for (i = 1; i < tric_batch_records(context); i++) {
+        context->record[i].used = false;
+    }
+    tric_prepare_record(context, before, after);
+    context->batch.length = 1;
+}
+
+
+
+/*
+internally used
+find record of the test currently executed in the process of a batch
+*/
+struct tric_record *tric_current_record(struct tric_context *context) {
+    size_t i = 0;
+    while (i + 1 < tric_batch_records(context) && context->record[i + 1].used) {
+        i++;
+    }
+    return &context->record[i];
+}
+
+
+
+/*
+internally used
+wait for the process executing a test or a batch and terminate it when the current test timed out
+return true if the test timed out
+*/
+bool tric_wait_test(struct tric_context *context, pid_t child, int *status, struct rusage *usage) {
+    struct pollfd process = { .fd = tric_open_process(child), .events = POLLIN };
+    bool timed_out = false;
+    while (wait4(child, status, WNOHANG, usage) == 0) {
+        double remaining = tric_remaining_time(tric_current_record(context));
+        if (remaining == 0) {
+            tric_kill_test(child);
+            timed_out = true;
+            wait4(child, status, 0, usage);
+            break;
+        }
+        if (remaining < 0 && tric_batch_records(context) < 2) {
+            wait4(child, status, 0, usage);
+            break;
+        }
+        /* tests of a batch may have a timeout even if the current test has none */
+        tric_wait_processes(&process, 1, remaining < 0 ? TRIC_BATCH_TIME : remaining);
+    }
+    if (process.fd >= 0) {
+        close(process.fd);
+    }
+    return timed_out;
+}
+
+
+
+/*
+internally used
+mark and report the tests executed in the process of a batch
+all tests but the last one were successful, the last one is marked according to the status of the process
+*/
+void tric_finish_batch(struct tric_context *context, int status, bool timed_out, const struct rusage *usage) {
+    struct tric_test *first = context->test;
+    struct tric_record *records = context->record;
+    size_t length = 1;
+    while (length < tric_batch_records(context) && records[length].used) {
+        length++;
+    }
+    if (records[length - 1].finished == false) {
+        records[length - 1].end_usage = *usage;
+    }
+    context->suite->executed_tests += length;
+    context->batch.pending = length - 1;
+    size_t i;
+    for (i = 0; i < length; i++) {
+        context->record = &records[i];
+        if (i + 1 < length && records[i].finished == false) {
+            records[i].end_usage = records[i + 1].start_usage;
+        }
+        tric_read_record(context);
+        if (records[i].finished) {
+            tric_set_status(context, records[i].status, records[i].before, records[i].after);
+            context->test->signal = records[i].signal;
+        } else if (i + 1 < length) {
+            tric_set_status(context, EXIT_OK, records[i].before, records[i].after);
+        } else {
+            tric_set_status(context, tric_exit_status(context->test, status, timed_out), records[i].before, records[i].after);
+            if (WIFSIGNALED(status) && timed_out == false) {
+                context->test->signal = WTERMSIG(status);
+            }
+        }
+        tric_report()->test(context->suite, context->test, tric_report()->data);
+        context->test = context->test->next;
+    }
+    context->test = first;
+    context->record = records;
+}
+
+
+
+/*
+internally used
+report test as not executed with the given status without creating a process
+*/
+void tric_omit_test(struct tric_context *context, enum tric_exit status, bool before, bool after) {
+    tric_end_batch(context);
+    context->mode = MODE_RESET;
+    if (context->queue) {
+        tric_set_job_status(context, tric_enqueue_job(context, before, after), status);
+        tric_report_jobs(context);
+        return;
+    }
+    tric_set_status(context, status, before, after);
+    tric_report()->test(context->suite, context->test, tric_report()->data);
+}
+
+
+
+/*
+internally used
+skip execution of test
+*/
+void tric_skip_test_execution(struct tric_context *context, tric_fixture_t before, tric_fixture_t after) {
+    if (context->mode != MODE_EXECUTE) {
+        return;
+    }
+    if (context->spawned > 0) {
+        if (context->test->id == context->spawned) {
+            _exit(EXIT_SKIP);
+        }
+        context->mode = MODE_RESET;
+        return;
+    }
+    /* a skipped test is reported by its own shard only, so the results of the shards add up */
+    if (tric_in_shard(context) == false) {
+        tric_omit_test(context, EXIT_NOT_IN_SHARD, false, false);
+        return;
+    }
+    tric_omit_test(context, EXIT_SKIP, before ? true : false, after ? true : false);
+}
+
+
+
+/*
+internally used
+execute test in separate process or prepare execution in the process of the test suite
+return true if the test is executed in the process of the test suite
+*/
+bool tric_run_test(struct tric_context *context, bool before, bool after) {
+    if (context->mode != MODE_EXECUTE) {
+        return false;
+    }
+    if (context->spawned > 0) {
+        tric_run_spawned_test(context);
+        return false;
+    }
+    /* tests of other shards and tests that are not selected are omitted without creating a process */
+    if (tric_in_shard(context) == false) {
+        tric_omit_test(context, EXIT_NOT_IN_SHARD, false, false);
+        return false;
+    }
+    if (tric_is_selected(context) == false) {
+        /* reported like a test skipped with its fixtures */
+        tric_omit_test(context, EXIT_SKIP, before, after);
+        return false;
+    }
+    if (tric_deferred(context)) {
+        tric_omit_test(context, EXIT_DEFERRED, false, false);
+        return false;
+    }
+    if (context->batch.child) {
+        tric_run_batch_test(context, before, after);
+        return false;
+    }
+    if (context->batch.pending > 0) {
+        context->batch.pending--;
+        context->mode = MODE_RESET;
+        return false;
+    }
+    if (tric_stopped(context)) {
+        tric_omit_test(context, EXIT_NOT_RUN, false, false);
+        return false;
+    }
+    /* a group sharing a before function is only started by a forked test, it must not affect tests executed in other ways */
+    context->batch.shared = context->queue == NULL && tric_shares_before(context, before);
+    if (tric_test_execution(context) == TRIC_EXECUTE_INLINE) {
+        tric_start_inline(context, before, after);
+        return true;
+    }
+    if (context->queue) {
+        tric_queue_test(context, before, after);
+        return false;
+    }
+    tric_start_batch(context, before, after);
+    pid_t child = tric_fork_test(context);
+    if (child == 0 && context->batch.shared) {
+        tric_start_group(context);
+        return false;
+    }
+    if (child == 0) {
+        /* resource limits can not be removed from the process for the following tests */
+        context->batch.child = context->batch.size > 1 && tric_has_limits(context->test) == false && tric_has_runs(context) == false;
+        clock_gettime(CLOCK_MONOTONIC, &context->batch.start);
+        tric_start_process(context);
+        return false;
+    }
+    context->mode = MODE_RESET;
+    if (child == -1) {
+        tric_set_status(context, EXIT_FORK, before, after);
+        tric_report()->test(context->suite, context->test, tric_report()->data);
+        return false;
+    }
+    setpgid(child, child);
+    int status;
+    struct rusage usage;
+    bool timed_out = tric_wait_test(context, child, &status, &usage);
+    size_t stragglers = tric_reap_group(child);
+    tric_current_record(context)->stragglers = timed_out ? 0 : stragglers;
+    tric_finish_batch(context, status, timed_out, &usage);
+    return false;
+}
+
+
+
+/*
+internally used
+execute before function of the first test of a group in the process of the group and fork a process for each test of the group
+the forked process of the test returns to execute the test without the before function
+*/
+void tric_run_shared_before(struct tric_context *context, tric_fixture_t before, void *data) {
+    struct tric_batch *batch = &context->batch;
+    struct tric_record *record = context->record;
+    if (batch->before == NULL) {
+        batch->before = before;
+        batch->data = data;
+        tric_start_record(context);
+        if (before(data) == false) {
+            tric_end_record(context);
+            record->status = EXIT_BEFORE_FAILURE;
+            record->finished = true;
+            _exit(EXIT_OK);
+        }
+    } else if (before != batch->before || data != batch->data) {
+        /* the test is executed by the process of the test suite */
+        record->used = false;
+        _exit(EXIT_OK);
+    }
+    pid_t child = fork();
+    if (child == 0) {
+        batch->child = false;
+        batch->shared = false;
+        tric_start_process(context);
+        return;
+    }
+    if (child == -1) {
+        /* the tests of the group were counted as executed */
+        record->status = EXIT_NOT_STARTED;
+        record->finished = true;
+        _exit(EXIT_OK);
+    }
+    int status;
+    wait4(child, &status, 0, &record->end_usage);
+    record->stragglers = tric_reap_group(child);
+    record->status = tric_exit_status(context->test, status, false);
+    record->signal = WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+    record->finished = true;
+    context->mode = MODE_RESET;
+}
+
+
+
+/*
+internally used
+execute before function of test
+*/
+void tric_run_before(struct tric_context *context, tric_fixture_t before, void *data) {
+    if (context->mode == MODE_EXECUTE && context->batch.shared) {
+        tric_run_shared_before(context, before, data);
+        return;
+    }
+    if (context->mode != MODE_EXECUTE
+    || before == NULL
+    || before(data)) {
+        return;
+    }
+    tric_end_record(context);
+    if (tric_is_inline(context)) {
+        tric_finish_inline(context, EXIT_BEFORE_FAILURE);
+        return;
+    }
+    _exit(EXIT_BEFORE_FAILURE);
+}
+
+
+
+/*
+internally used
+execute after function of test
+*/
+void tric_run_after(struct tric_context *context, tric_fixture_t after, void *data) {
+    bool result = after == NULL || after(data);
+    tric_end_record(context);
+    if (tric_is_inline(context)) {
+        tric_finish_inline(context, result ? EXIT_OK : EXIT_AFTER_FAILURE);
+        return;
+    }
+    if (result && context->batch.child) {
+        return;
+    }
+    _exit(result ? EXIT_OK : EXIT_AFTER_FAILURE);
+}
+
+
+
+/*
+internally used
+check if all tests of the suite are executed in spawned processes
+a test that sets another execution option, e.g. an inline test, is executed by the process of the test suite
+*/
+bool tric_all_spawned(struct tric_context *context) {
+    if (context->records_file < 0 || tric_settings()->execution != TRIC_EXECUTE_SPAWN) {
+        return false;
+    }
+    struct tric_test *test;
+    for (test = context->suite->tests; test != NULL; test = test->next) {
+        if (test->options.execution != TRIC_EXECUTE_DEFAULT && test->options.execution != TRIC_EXECUTE_SPAWN) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+/*
+internally used
+check if code of fixture block should run and wait for tests running in parallel
+*/
+bool tric_fixture(struct tric_context *context) {
+    if (context->mode != MODE_RESET) {
+        return false;
+    }
+    tric_end_batch(context);
+    tric_finish_jobs(context);
+    /* if all tests are spawned, only their processes need the data prepared by fixture blocks */
+    return context->spawned > 0 || tric_all_spawned(context) == false;
+}
+
+
+
+/*
+internally used
+default log function running at start of suite
+*/
+void tric_log_start(struct tric_suite *suite, struct tric_test *test, void *data) {
+    printf("test suite \"%s\" (%zu %s found):\n\n", suite->description, suite->number_of_tests, suite->number_of_tests == 1 ? "test" : "tests");
+}
+
+
+
+/*
+internally used
+default log function running after each test
+*/
+void tric_log_test(struct tric_suite *suite, struct tric_test *test, void *data) {
+    if (test->result == TRIC_FAILURE) {
+        printf("test %zu of %zu (\"%s\") failed at line %zu\n", test->id, suite->number_of_tests, test->description, test->line);
+    } else if (test->result == TRIC_CRASHED) {
+        printf("test %zu of %zu (\"%s\") crashed with signal %zu\n", test->id, suite->number_of_tests, test->description, test->signal);
+#ifdef __GLIBC__
+        if (test->frames > 0) {
+            fflush(stdout);
+            backtrace_symbols_fd(test->backtrace, test->frames, STDOUT_FILENO);
+        }
+#endif
+    } else if (test->result == TRIC_TIMEOUT) {
+        printf("test %zu of %zu (\"%s\") timed out after %.3f seconds\n", test->id, suite->number_of_tests, test->description, test->duration);
+    } else if (test->result == TRIC_EXCEEDED) {
+        printf("test %zu of %zu (\"%s\") exceeded a resource limit (signal %zu)\n", test->id, suite->number_of_tests, test->description, test->signal);
+    }
+    if (test->result == TRIC_OK && test->failed_runs > 0) {
+        printf("test %zu of %zu (\"%s\") passed after %zu failed %s\n", test->id, suite->number_of_tests, test->description, test->failed_runs, test->failed_runs == 1 ? "run" : "runs");
+    }
+    if (test->stragglers > 0) {
+        printf("test %zu of %zu (\"%s\") left %zu running %s\n", test->id, suite->number_of_tests, test->description, test->stragglers, test->stragglers == 1 ? "process" : "processes");
+    }
+}
+
+
+
+/*
+internally used
+default log function running at end of suite
+*/
+void tric_log_end(struct tric_suite *suite, struct tric_test *test, void *data) {
+    printf("\n%zu %s executed, %zu failed, %zu skipped", suite->executed_tests, suite->executed_tests == 1 ? "test" : "tests", suite->failed_tests, suite->skipped_tests);
+    if (suite->not_in_shard_tests > 0) {
+        printf(", %zu not in shard", suite->not_in_shard_tests);
+    }
+    if (suite->not_run_tests > 0) {
+        printf(", %zu not run", suite->not_run_tests);
+    }
+    if (suite->deferred_tests > 0) {
+        printf(", %zu deferred", suite->deferred_tests);
+    }
+    printf(", %zu total\n", suite->number_of_tests);
+    if (tric_settings()->jobs > 1) {
+        printf("%.3f seconds elapsed, %.3f seconds cpu time of the tests\n", suite->duration, suite->cpu_time);
+    }
+}
+
+
+
+/*
+internally used
+log function producing no output
+*/
+void tric_log_nothing(struct tric_suite *suite, struct tric_test *test, void *data) {
+    return;
+}
+
+
+
+/*
+internally used
+function to hold global reporting data
+*/
+struct tric_reporting_data *tric_reporting(bool set, tric_logger_t start, tric_logger_t test, tric_logger_t end, void *data) {
+    static struct tric_reporting_data reporting = { .start = tric_log_start, .test = tric_log_test, .end = tric_log_end, .data = NULL };
+    if (set) {
+        reporting.start = start ? start : tric_log_nothing;
+        reporting.test = test ? test : tric_log_nothing;
+        reporting.end = end ? end : tric_log_nothing;
+        reporting.data = data;
+    }
+    return &reporting;
+}
+
+
+
+/*
+internally used
+retrieve global reporting data
+*/
+struct tric_reporting_data *tric_report(void) {
+    return tric_reporting(false, NULL, NULL, NULL, NULL);
+}
+
+
+
+/**
+ * \brief Set the log functions to report the test results.
+ *
+ * Logging can take place in 3 situations: At the start of the test suite (before any test is executed), directly after the execution of each test and at the end of the test suite (after all tests have been executed). When a log function is called at the start or end of the test suite, the test argument passed to the log function is NULL.
+ *
+ * \param start Function of type tric_logger_t that is executed after the setup fixture of the test suite has run and after the tests have been scanned but before any test is executed. May be NULL.
+ * \param test Function of type tric_logger_t that is executed each time after a test was executed. May be NULL.
+ * \param end Function of type tric_logger_t that is executed  after all tests have been executed but before the teardown fixture of the test suite is run. May be NULL.
+ * \param data Pointer to user data that is passed to the logging functions.
+ */
+void tric_log(tric_logger_t start, tric_logger_t test, tric_logger_t end, void *data) {
+    tric_reporting(true, start, test, end, data);
+}
+
+
+
+/**
+ * \brief Set how the tests of the test suite are executed.
+ *
+ * By default each test is executed in a separate process (TRIC_EXECUTE_FORK). When TRIC_EXECUTE_INLINE is set, all tests that do not set the execution option themselves are executed in the process of the test suite like tests created with the INLINE_TEST macro. When TRIC_EXECUTE_SPAWN is set, these tests are executed in new processes of the test suite and fixture blocks are only executed by these processes, unless a test sets a different execution option. TRIC_EXECUTE_DEFAULT restores the default.
+ *
+ * This function must be called before any test in the test suite is executed (i.e. in the test suite setup fixture).
+ *
+ * \param execution Execution of the tests of the test suite.
+ */
+void tric_execute(enum tric_execution execution) {
+    tric_settings()->execution = execution == TRIC_EXECUTE_DEFAULT ? TRIC_EXECUTE_FORK : execution;
+}
+
+
+
+/*
+internally used
+execute setup or teardown function of test suite
+*/
+bool tric_run_fixture(tric_fixture_t fixture, void *data) {
+    if (fixture == NULL) {
+        return true;
+    }
+    return fixture(data);
+}
+
+
+
+/*
+internally used
+scan suite for tests
+*/
+void tric_scan_tests(struct tric_context *context) {
+    context->mode = MODE_SCAN;
+    context->test = NULL;
+    tric_suite_function(context);
+    context->mode = MODE_RESET;
+}
+
+
+
+/*
+internally used
+convert value of environment variable to positive number, 1 if not set or invalid
+*/
+size_t tric_count(const char *value) {
+    if (value == NULL) {
+        return 1;
+    }
+    char *end;
+    unsigned long count = strtoul(value, &end, 10);
+    if (*value < '0' || *value > '9' || *end != '\0' || count < 1) {
+        return 1;
+    }
+    return count;
+}
+
+
+
+/*
+internally used
+order entries of the linker section by the position of the test
+*/
+int tric_compare_entries(const void *entry1, const void *entry2) {
+    size_t order1 = ((const struct tric_entry *)entry1)->order;
+    size_t order2 = ((const struct tric_entry *)entry2)->order;
+    return (order1 > order2) - (order1 < order2);
+}
+
+
+
+/*
+internally used
+add tests of the linker section to the suite in the order of the test suite
+return false if there are no entries or if tests are created for each case of a table
+*/
+bool tric_register_tests(struct tric_context *context, struct tric_entry *first, struct tric_entry *last) {
+    if (first == NULL || last == NULL || first >= last) {
+        return false;
+    }
+    struct tric_entry *entry;
+    for (entry = first; entry < last; entry++) {
+        if (entry->test == NULL) {
+            return false;
+        }
+    }
+    qsort(first, last - first, sizeof(struct tric_entry), tric_compare_entries);
+    context->mode = MODE_SCAN;
+    context->test = NULL;
+    for (entry = first; entry < last; entry++) {
+        tric_add_test(context, entry->test);
+    }
+    context->mode = MODE_RESET;
+    return true;
+}
+
+
+
+/*
+internally used
+find tests in the linker section or scan suite for tests if there are none
+*/
+void tric_find_tests(struct tric_context *context) {
+#ifdef TRIC_SECTIONS
+    if (tric_register_tests(context, __start_tric_tests, __stop_tric_tests)) {
+        return;
+    }
+#endif
+    tric_scan_tests(context);
+}
+
+
+
+/*
+internally used
+move the tests found in the test suite into a contiguous table in the order of their IDs and link the list through the table
+keep the scattered tests if the table can not be allocated
+*/
+void tric_store_tests(struct tric_suite *suite) {
+    if (suite->number_of_tests == 0 || suite->table != NULL) {
+        return;
+    }
+    struct tric_test *table = malloc(suite->number_of_tests * sizeof(struct tric_test));
+    if (table == NULL) {
+        return;
+    }
+    struct tric_test *test = suite->tests;
+    size_t i;
+    for (i = 0; i < suite->number_of_tests && test != NULL; i++, test = test->next) {
+        table[i] = *test;
+        table[i].next = &table[i + 1];
+    }
+    table[i - 1].next = NULL;
+    suite->tests = table;
+    suite->table = table;
+}
+
+
+
+/*
+internally used
+free the table of the tests and the tests created for each case of a table, whose descriptions follow them in the same allocation
+the tests created for each case are only freed together with the table, since the scattered tests are linked through them otherwise
+*/
+void tric_free_tests(struct tric_suite *suite) {
+    if (suite->table == NULL) {
+        return;
+    }
+    struct tric_test *test;
+    for (test = suite->tests; test != NULL; test = test->next) {
+        if (test->cases > 0 && test->index == 0) {
+            free((struct tric_test *)test->description - test->cases);
+        }
+    }
+    free(suite->table);
+    suite->table = NULL;
+    suite->tests = NULL;
+}
+
+
+
+/**
+ * \brief Look up a test of the test suite by its ID.
+ *
+ * Once the tests are executed, the lookup takes constant time. This function can be used in custom logging functions (see tric_log()).
+ *
+ * \param suite The test suite.
+ * \param id The ID of the test (IDs start at 1).
+ *
+ * \return The test with the given ID or NULL if the test suite has no test with this ID.
+ */
+struct tric_test *tric_suite_test(struct tric_suite *suite, size_t id) {
+    if (id == 0 || id > suite->number_of_tests) {
+        return NULL;
+    }
+    if (suite->table != NULL) {
+        return &suite->table[id - 1];
+    }
+    struct tric_test *test = suite->tests;
+    while (test != NULL && test->id != id) {
+        test = test->next;
+    }
+    return test;
+}
+
+
+
+/*
+internally used
+names of the results of the tests in the history file
+*/
+const char *tric_result_name(enum tric_result result) {
+    static const char *names[] = { "undefined", "ok", "failure", "skipped", "crashed", "timeout", "exceeded", "not_in_shard", "not_run", "deferred" };
+    return names[result + 1];
+}
+
+
+
+/*
+internally used
+determine result from its name in the history file, TRIC_UNDEFINED if the name is unknown
+*/
+enum tric_result tric_result_value(const char *name) {
+    enum tric_result result;
+    for (result = TRIC_OK; result <= TRIC_DEFERRED; result++) {
+        if (strcmp(tric_result_name(result), name) == 0) {
+            return result;
+        }
+    }
+    return TRIC_UNDEFINED;
+}
+
+
+
+/*
+internally used
+parse a line of the history file, the fields are separated by tabs and the description of the test is the last field
+return the test of the suite the line belongs to or NULL if the line belongs to another test suite or to a test that changed
+*/
+struct tric_test *tric_history_test(struct tric_suite *suite, char *line, enum tric_result *result, double *duration) {
+    size_t length = strlen(suite->description);
+    if (strncmp(line, suite->description, length) != 0 || line[length] != '\t') {
+        return NULL;
+    }
+    char name[16];
+    size_t id;
+    int description = 0;
+    if (sscanf(line + length, "\t%zu\t%15[a-z_]\t%lf\t%n", &id, name, duration, &description) != 3 || description == 0) {
+        return NULL;
+    }
+    char *text = line + length + description;
+    text[strcspn(text, "\n")] = '\0';
+    struct tric_test *test = tric_suite_test(suite, id);
+    if (test == NULL || strcmp(test->description, text) != 0) {
+        return NULL;
+    }
+    *result = tric_result_value(name);
+    return test;
+}
+
+
+
+/*
+internally used
+read the results and durations of the tests of the suite in the previous run from the history file
+*/
+void tric_read_history(struct tric_suite *suite, const char *path) {
+    FILE *file = path != NULL ? fopen(path, "r") : NULL;
+    if (file == NULL) {
+        return;
+    }
+    char *line = NULL;
+    size_t size = 0;
+    while (getline(&line, &size, file) != -1) {
+        enum tric_result result;
+        double duration;
+        struct tric_test *test = tric_history_test(suite, line, &result, &duration);
+        if (test != NULL) {
+            test->previous_result = result;
+            test->previous_duration = duration;
+        }
+    }
+    free(line);
+    fclose(file);
+}
+
+
+
+/*
+internally used
+write the results and durations of the tests of the suite to the history file
+the lines of other test suites are kept, tests that were not executed keep their previous result
+deferred tests are recorded as deferred unless they failed before, so they are preferred over the tests executed in this run next time
+a shard only reads the history, since all shards must compute their distribution from the same file (the merged results are recorded by tric_merge)
+the file is replaced by a temporary file with a unique name, so test suites writing the same file at the same time do not mix their lines
+*/
+void tric_write_history(struct tric_suite *suite, const char *path) {
+    if (path == NULL || tric_settings()->shard_count > 1) {
+        return;
+    }
+    size_t length = strlen(path);
+    char *temporary = malloc(length + sizeof(".XXXXXX"));
+    if (temporary == NULL) {
+        return;
+    }
+    memcpy(temporary, path, length);
+    memcpy(temporary + length, ".XXXXXX", sizeof(".XXXXXX"));
+    int file = mkstemp(temporary);
+    FILE *output = file >= 0 ? fdopen(file, "w") : NULL;
+    if (output == NULL) {
+        if (file >= 0) {
+            close(file);
+            remove(temporary);
+        }
+        free(temporary);
+        return;
+    }
+    FILE *input = fopen(path, "r");
+    if (input != NULL) {
+        char *line = NULL;
+        size_t size = 0;
+        size_t description = strlen(suite->description);
+        while (getline(&line, &size, input) != -1) {
+            if (strncmp(line, suite->description, description) != 0 || line[description] != '\t') {
+                fputs(line, output);
+            }
+        }
+        free(line);
+        fclose(input);
+    }
+    struct tric_test *test;
+    for (test = suite->tests; test != NULL; test = test->next) {
+        bool executed = test->result != TRIC_UNDEFINED && test->result != TRIC_SKIPPED && test->result != TRIC_NOT_IN_SHARD && test->result != TRIC_NOT_RUN && test->result != TRIC_DEFERRED;
+        enum tric_result result = executed ? test->result : test->previous_result;
+        if (test->result == TRIC_DEFERRED && result != TRIC_UNDEFINED && tric_failed_result(result) == false) {
+            result = TRIC_DEFERRED;
+        }
+        double duration = executed ? test->duration : test->previous_duration;
+        if (result != TRIC_UNDEFINED && duration >= 0) {
+            fprintf(output, "%s\t%zu\t%s\t%.9f\t%s\n", suite->description, test->id, tric_result_name(result), duration, test->description);
+        }
+    }
+    if (fclose(output) == 0) {
+        rename(temporary, path);
+    } else {
+        remove(temporary);
+    }
+    free(temporary);
+}
+
+
+
+/*
+internally used
+entry of a test sorted by its estimated duration when the tests are distributed to the shards or scheduled
+*/
+struct tric_duration_entry {
+    double duration;
+    struct tric_test *test;
+};
+
+
+
+/*
+internally used
+order tests by descending duration and by ID for equal durations, so all shards compute the same distribution
+*/
+int tric_compare_durations(const void *entry1, const void *entry2) {
+    const struct tric_duration_entry *first = entry1;
+    const struct tric_duration_entry *second = entry2;
+    if (first->duration != second->duration) {
+        return first->duration < second->duration ? 1 : -1;
+    }
+    return (first->test->id > second->test->id) - (first->test->id < second->test->id);
 }
 
 
 
 /*
 internally used
-prepare execution context to run test
+distribute the tests of the suite to the shards
+with durations in the history the longest test is assigned to the shard with the least total duration first, tests without duration are estimated with the average duration
+without durations the tests are distributed by their ID
 */
-void tric_reset_context(struct tric_context *context, struct tric_test *test) {
-    if (context->mode != MODE_RESET) {
+void tric_assign_shards(struct tric_suite *suite, size_t count) {
+    if (count <= 1) {
         return;
     }
-    context->mode = MODE_EXECUTE;
-    lseek(context->self, 0, SEEK_SET);
-    context->test = test;
+    struct tric_test *test;
+    size_t known = 0;
+    double total = 0;
+    for (test = suite->tests; test != NULL; test = test->next) {
+        test->shard = (test->id - 1) % count;
+        if (test->previous_duration >= 0) {
+            known++;
+            total += test->previous_duration;
+        }
+    }
+    struct tric_duration_entry *entries = known > 0 ? malloc(suite->number_of_tests * sizeof(struct tric_duration_entry)) : NULL;
+    double *loads = entries != NULL ? calloc(count, sizeof(double)) : NULL;
+    if (loads == NULL) {
+        free(entries);
+        return;
+    }
+    size_t i = 0;
+    for (test = suite->tests; test != NULL; test = test->next, i++) {
+        entries[i].duration = test->previous_duration >= 0 ? test->previous_duration : total / known;
+        entries[i].test = test;
+    }
+    qsort(entries, suite->number_of_tests, sizeof(struct tric_duration_entry), tric_compare_durations);
+    for (i = 0; i < suite->number_of_tests; i++) {
+        size_t shard = 0;
+        size_t j;
+        for (j = 1; j < count; j++) {
+            if (loads[j] < loads[shard]) {
+                shard = j;
+            }
+        }
+        entries[i].test->shard = shard;
+        loads[shard] += entries[i].duration;
+    }
+    free(loads);
+    free(entries);
 }
 
 
 
 /*
 internally used
-mark test as successful
+priority of a test for the time budget from its result in the previous run
+tests that failed come first, then new tests (including tests whose description changed), tests deferred before and tests that passed last
 */
-void tric_status_ok(struct tric_context *context, bool before, bool after) {
-    context->test->before = before ? TRIC_OK : TRIC_UNDEFINED;
-    context->test->result = TRIC_OK;
-    context->test->after = after ? TRIC_OK : TRIC_UNDEFINED;
+int tric_budget_priority(const struct tric_test *test) {
+    if (tric_failed_result(test->previous_result)) {
+        return 0;
+    }
+    if (test->previous_result == TRIC_UNDEFINED) {
+        return 1;
+    }
+    return test->previous_result == TRIC_DEFERRED ? 2 : 3;
 }
 
 
 
 /*
 internally used
-mark test as failed
+order tests by priority for the time budget, by ascending duration to fit as many tests as possible and by ID for equal durations
 */
-void tric_status_fail(struct tric_context *context, bool before, bool after) {
-    context->suite->failed_tests++;
-    context->test->line = lseek(context->self, 0, SEEK_CUR);
-    context->test->before = before ? TRIC_OK : TRIC_UNDEFINED;
-    context->test->result = TRIC_FAILURE;
-    context->test->after = after ? TRIC_SKIPPED : TRIC_UNDEFINED;
+int tric_compare_priorities(const void *entry1, const void *entry2) {
+    const struct tric_duration_entry *first = entry1;
+    const struct tric_duration_entry *second = entry2;
+    int priority1 = tric_budget_priority(first->test);
+    int priority2 = tric_budget_priority(second->test);
+    if (priority1 != priority2) {
+        return priority1 - priority2;
+    }
+    if (first->duration != second->duration) {
+        return first->duration > second->duration ? 1 : -1;
+    }
+    return (first->test->id > second->test->id) - (first->test->id < second->test->id);
 }
 
 
 
 /*
 internally used
-mark test as failed in before function
+select the test longer than the whole time budget that is executed anyway, otherwise these tests would be deferred in every run
+a test that failed before or is new is selected first, the other tests are selected in turn by their IDs after the one executed in the previous run
 */
-void tric_status_fail_before(struct tric_context *context, bool before, bool after) {
-    context->suite->failed_tests++;
-    context->test->before = TRIC_FAILURE;
-    context->test->result = TRIC_SKIPPED;
-    context->test->after = after ? TRIC_SKIPPED : TRIC_UNDEFINED;
+struct tric_test *tric_over_budget(const struct tric_duration_entry *entries, size_t count, double budget) {
+    struct tric_test *first = NULL;
+    size_t last = 0;
+    size_t i;
+    for (i = 0; i < count; i++) {
+        if (entries[i].duration <= budget) {
+            continue;
+        }
+        first = first != NULL ? first : entries[i].test;
+        if (entries[i].test->previous_result != TRIC_DEFERRED && entries[i].test->id > last) {
+            last = entries[i].test->id;
+        }
+    }
+    if (first == NULL || tric_budget_priority(first) < 2) {
+        return first;
+    }
+    struct tric_test *next = NULL;
+    struct tric_test *lowest = NULL;
+    for (i = 0; i < count; i++) {
+        struct tric_test *test = entries[i].test;
+        if (entries[i].duration <= budget) {
+            continue;
+        }
+        if (lowest == NULL || test->id < lowest->id) {
+            lowest = test;
+        }
+        if (test->id > last && (next == NULL || test->id < next->id)) {
+            next = test;
+        }
+    }
+    return next != NULL ? next : lowest;
 }
 
 
 
 /*
 internally used
-mark test as failed in after function
+select the tests of the current shard fitting into the time budget and defer all other tests
+the durations of the history are used, tests without duration are estimated with the average duration
+the budget is multiplied by the number of jobs if the tests are executed in parallel
+one of the tests longer than the budget is executed anyway
 */
-void tric_status_fail_after(struct tric_context *context, bool before, bool after) {
-    context->test->before = before ? TRIC_OK : TRIC_UNDEFINED;
-    context->test->result = TRIC_OK;
-    context->test->after = TRIC_FAILURE;
+void tric_defer_tests(struct tric_suite *suite, double budget, size_t jobs) {
+    if (budget <= 0 || suite->number_of_tests == 0) {
+        return;
+    }
+    struct tric_duration_entry *entries = malloc(suite->number_of_tests * sizeof(struct tric_duration_entry));
+    if (entries == NULL) {
+        return;
+    }
+    size_t known = 0;
+    double total = 0;
+    size_t count = 0;
+    struct tric_test *test;
+    for (test = suite->tests; test != NULL; test = test->next) {
+        struct tric_context context = { .suite = suite, .test = test };
+        if (tric_in_shard(&context) && tric_is_selected(&context)) {
+            entries[count++].test = test;
+            if (test->previous_duration >= 0) {
+                known++;
+                total += test->previous_duration;
+            }
+        }
+    }
+    size_t i;
+    for (i = 0; i < count; i++) {
+        double duration = entries[i].test->previous_duration;
+        entries[i].duration = duration >= 0 ? duration : (known > 0 ? total / known : 0);
+    }
+    qsort(entries, count, sizeof(struct tric_duration_entry), tric_compare_priorities);
+    double available = budget * (jobs > 1 ? jobs : 1);
+    for (i = 0; i < count; i++) {
+        if (entries[i].duration <= budget && entries[i].duration <= available) {
+            available -= entries[i].duration;
+        } else {
+            entries[i].test->deferred = true;
+        }
+    }
+    struct tric_test *over_budget = tric_over_budget(entries, count, budget);
+    if (over_budget != NULL) {
+        over_budget->deferred = false;
+        over_budget->over_budget = true;
+    }
+    free(entries);
 }
 
 
 
 /*
 internally used
-mark test as failed due to signal
+determine index of the shard to execute from value of environment variable TRIC_SHARD_INDEX, 0 if not set and SIZE_MAX if invalid
 */
-void tric_status_crash(struct tric_context *context, bool before, bool after) {
-    context->suite->failed_tests++;
-    context->test->before = before ? TRIC_CRASHED : TRIC_UNDEFINED;
-    context->test->result = TRIC_CRASHED;
-    context->test->after = after ? TRIC_CRASHED : TRIC_UNDEFINED;
+size_t tric_shard_index(const char *value) {
+    if (value == NULL) {
+        return 0;
+    }
+    char *end;
+    unsigned long index = strtoul(value, &end, 10);
+    if (*value < '0' || *value > '9' || *end != '\0') {
+        return SIZE_MAX;
+    }
+    return index;
 }
 
 
 
 /*
 internally used
-mark test as failed due to fork error
+determine number of the test suite to execute from value of environment variable TRIC_SUITE, 0 if not set or invalid
 */
-void tric_status_fail_fork(struct tric_context *context, bool before, bool after) {
-    context->suite->skipped_tests++;
-    context->test->before = TRIC_UNDEFINED;
-    context->test->result = TRIC_UNDEFINED;
-    context->test->after = TRIC_UNDEFINED;
+size_t tric_suite_number(const char *value) {
+    if (value == NULL) {
+        return 0;
+    }
+    char *end;
+    unsigned long number = strtoul(value, &end, 10);
+    if (*value < '0' || *value > '9' || *end != '\0') {
+        return 0;
+    }
+    return number;
 }
 
 
 
 /*
 internally used
-mark test as skipped
+determine number of tests to execute in parallel from value of environment variable TRIC_JOBS, at most TRIC_JOBS_LIMIT
 */
-void tric_status_skip(struct tric_context *context, bool before, bool after) {
-    context->suite->skipped_tests++;
-    context->test->before = before ? TRIC_SKIPPED : TRIC_UNDEFINED;
-    context->test->result = TRIC_SKIPPED;
-    context->test->after = after ? TRIC_SKIPPED : TRIC_UNDEFINED;
+size_t tric_jobs(const char *value) {
+    size_t jobs = tric_count(value);
+    if (value != NULL && strcmp(value, "auto") == 0) {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        jobs = processors > 1 ? processors : 1;
+    }
+    return jobs < TRIC_JOBS_LIMIT ? jobs : TRIC_JOBS_LIMIT;
 }
 
 
 
 /*
 internally used
-mark test according to exit status
+determine number of tests to execute in the same process from value of environment variable TRIC_BATCH
 */
-void tric_set_status(struct tric_context *context, enum tric_exit status, bool before, bool after) {
-    static const tric_status_t states[] = {
-        [EXIT_OK] = tric_status_ok,
-        [EXIT_TEST_FAILURE] = tric_status_fail,
-        [EXIT_BEFORE_FAILURE] = tric_status_fail_before,
-        [EXIT_AFTER_FAILURE] = tric_status_fail_after,
-        [EXIT_SIGNAL] = tric_status_crash,
-        [EXIT_FORK] = tric_status_fail_fork,
-        [EXIT_SKIP] = tric_status_skip
-    };
-    states[status](context, before, after);
+struct tric_batch tric_batch(const char *value) {
+    if (value != NULL && strcmp(value, "auto") == 0) {
+        return (struct tric_batch){ .size = TRIC_BATCH_LIMIT, .adaptive = true };
+    }
+    return (struct tric_batch){ .size = tric_count(value), .adaptive = false };
 }
 
 
 
 /*
 internally used
-execute test in separate process
+determine timeout of the tests in seconds from value of environment variable TRIC_TEST_TIMEOUT, 0 if not set or invalid
 */
-void tric_run_test(struct tric_context *context, bool before, bool after) {
-    if (context->mode != MODE_EXECUTE) {
-        return;
-    }
-    pid_t child = fork();
-    if (child == 0) {
-        return;
-    }
-    context->mode = MODE_RESET;
-    if (child == -1) {
-        tric_set_status(context, EXIT_FORK, before, after);
-        tric_report()->test(context->suite, context->test, tric_report()->data);
-        return;
+double tric_timeout(const char *value) {
+    if (value == NULL) {
+        return 0;
     }
-    context->suite->executed_tests++;
-    int status;
-    waitpid(child, &status, 0);
-    if (WIFSIGNALED(status)) {
-        tric_set_status(context, EXIT_SIGNAL, before, after);
-        context->test->signal = WTERMSIG(status);
-    } else {
-        tric_set_status(context, WEXITSTATUS(status), before, after);
+    char *end;
+    double timeout = strtod(value, &end);
+    if (end == value || *end != '\0' || (timeout > 0) == false) {
+        return 0;
     }
-    tric_report()->test(context->suite, context->test, tric_report()->data);
+    return timeout;
 }
 
 
 
 /*
 internally used
-execute before function of test
+determine number of failed tests after which the test suite is stopped from value of environment variable TRIC_MAX_FAILURES, 0 if not set or invalid
 */
-void tric_run_before(struct tric_context *context, tric_fixture_t before, void *data) {
-    if (context->mode != MODE_EXECUTE
-    || before == NULL
-    || before(data)) {
-        return;
+size_t tric_max_failures(const char *value) {
+    if (value == NULL) {
+        return 0;
     }
-    _exit(EXIT_BEFORE_FAILURE);
+    char *end;
+    unsigned long max_failures = strtoul(value, &end, 10);
+    if (*value < '0' || *value > '9' || *end != '\0') {
+        return 0;
+    }
+    return max_failures;
 }
 
 
 
 /*
 internally used
-execute after function of test
+determine time budget of the test suite in seconds from value of environment variable TRIC_TIME_BUDGET, 0 if not set or invalid
+the number can be followed by "s" for seconds or "m" for minutes
 */
-void tric_run_after(tric_fixture_t after, void *data) {
-    if (after == NULL
-    || after(data)) {
-        _exit(EXIT_OK);
+double tric_time_budget(const char *value) {
+    if (value == NULL) {
+        return 0;
+    }
+    char *end;
+    double budget = strtod(value, &end);
+    if (end == value || (budget > 0) == false) {
+        return 0;
+    }
+    if (strcmp(end, "m") == 0) {
+        return budget * 60;
     }
-    _exit(EXIT_AFTER_FAILURE);
+    return *end == '\0' || strcmp(end, "s") == 0 ? budget : 0;
 }
 
 
 
 /*
 internally used
-skip execution of test
+determine how often a failing test is executed again from value of environment variable TRIC_RETRIES, 0 if not set or invalid
 */
-void tric_skip_test_execution(struct tric_context *context, tric_fixture_t before, tric_fixture_t after) {
-    if (context->mode != MODE_EXECUTE) {
-        return;
+size_t tric_retries(const char *value) {
+    if (value == NULL) {
+        return 0;
     }
-    context->mode = MODE_RESET;
-    tric_set_status(context, EXIT_SKIP, before ? true : false, after ? true : false);
-    tric_report()->test(context->suite, context->test, tric_report()->data);
+    char *end;
+    unsigned long retries = strtoul(value, &end, 10);
+    if (*value < '0' || *value > '9' || *end != '\0') {
+        return 0;
+    }
+    return retries;
 }
 
 
 
 /*
 internally used
-default log function running at start of suite
+rank the tests by the results and durations of the history, held tests are started in the order of their ranks
+with TRIC_FAILED_FIRST the tests that failed in the previous run come first
+if the tests are executed in parallel, the other tests follow by descending duration and tests without duration come last in the order of the test suite
+return NULL to start each test when it is reached, if no test failed before and the tests are not executed in parallel or no duration is known
 */
-void tric_log_start(struct tric_suite *suite, struct tric_test *test, void *data) {
-    printf("test suite \"%s\" (%zu %s found):\n\n", suite->description, suite->number_of_tests, suite->number_of_tests == 1 ? "test" : "tests");
+size_t *tric_create_schedule(struct tric_suite *suite, size_t jobs) {
+    bool failed_first = tric_settings()->failed_first;
+    size_t failed = 0;
+    size_t known = 0;
+    struct tric_test *test;
+    for (test = suite->tests; test != NULL; test = test->next) {
+        if (failed_first && tric_failed_result(test->previous_result)) {
+            failed++;
+        } else if (test->previous_duration >= 0) {
+            known++;
+        }
+    }
+    bool balanced = jobs > 1 && known > 0;
+    if ((balanced == false && failed == 0) || suite->table == NULL) {
+        return NULL;
+    }
+    size_t *ranks = malloc(suite->number_of_tests * sizeof(size_t));
+    struct tric_duration_entry *entries = balanced ? malloc(known * sizeof(struct tric_duration_entry)) : NULL;
+    if (ranks == NULL || (balanced && entries == NULL)) {
+        free(ranks);
+        free(entries);
+        return NULL;
+    }
+    size_t rank = 0;
+    size_t i = 0;
+    for (test = suite->tests; test != NULL; test = test->next) {
+        if (failed_first && tric_failed_result(test->previous_result)) {
+            ranks[test->id - 1] = rank++;
+        } else if (balanced && test->previous_duration >= 0) {
+            entries[i++] = (struct tric_duration_entry){ .duration = test->previous_duration, .test = test };
+            ranks[test->id - 1] = SIZE_MAX;
+        } else {
+            ranks[test->id - 1] = SIZE_MAX;
+        }
+    }
+    if (balanced) {
+        qsort(entries, known, sizeof(struct tric_duration_entry), tric_compare_durations);
+        for (i = 0; i < known; i++) {
+            ranks[entries[i].test->id - 1] = rank++;
+        }
+    }
+    for (test = suite->tests; test != NULL; test = test->next) {
+        if (ranks[test->id - 1] == SIZE_MAX) {
+            ranks[test->id - 1] = rank++;
+        }
+    }
+    free(entries);
+    return ranks;
 }
 
 
 
 /*
 internally used
-default log function running after each test
+prepare queue to execute tests in parallel or to start the tests one after another in the order of their ranks
 */
-void tric_log_test(struct tric_suite *suite, struct tric_test *test, void *data) {
-    if (test->result == TRIC_FAILURE) {
-        printf("test %zu of %zu (\"%s\") failed at line %zu\n", test->id, suite->number_of_tests, test->description, test->line);
-    } else if (test->result == TRIC_CRASHED) {
-        printf("test %zu of %zu (\"%s\") crashed with signal %zu\n", test->id, suite->number_of_tests, test->description, test->signal);
+struct tric_queue *tric_create_queue(struct tric_queue *queue, size_t number_of_tests) {
+    if (queue->jobs < 2 && queue->ranks == NULL) {
+        return NULL;
     }
+    queue->running = 0;
+    queue->held = 0;
+    queue->head = 0;
+    queue->length = 0;
+    queue->capacity = number_of_tests > queue->jobs ? number_of_tests : queue->jobs;
+    queue->entries = malloc(queue->capacity * sizeof(struct tric_job));
+    return queue->entries ? queue : NULL;
 }
 
 
 
 /*
 internally used
-default log function running at end of suite
+add up the CPU time of the tests of the suite
 */
-void tric_log_end(struct tric_suite *suite, struct tric_test *test, void *data) {
-    printf("\n%zu %s executed, %zu failed, %zu skipped, %zu total\n", suite->executed_tests, suite->executed_tests == 1 ? "test" : "tests", suite->failed_tests, suite->skipped_tests, suite->number_of_tests);
+void tric_sum_cpu_time(struct tric_suite *suite) {
+    suite->cpu_time = 0;
+    struct tric_test *test;
+    for (test = suite->tests; test != NULL; test = test->next) {
+        suite->cpu_time += test->user_time + test->system_time;
+    }
 }
 
 
 
 /*
 internally used
-log function producing no output
+execute tests of suite
 */
-void tric_log_nothing(struct tric_suite *suite, struct tric_test *test, void *data) {
-    return;
+int tric_run_tests(struct tric_context *context) {
+    context->mode = MODE_RESET;
+    if (tric_run_fixture(tric_data()->setup, tric_data()->data) == false) {
+        return EX_UNAVAILABLE;
+    }
+    tric_report()->start(context->suite, NULL, tric_report()->data);
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &context->start);
+    tric_suite_function(context);
+    tric_end_batch(context);
+    tric_finish_jobs(context);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    context->suite->duration = tric_seconds(&context->start, &end);
+    tric_sum_cpu_time(context->suite);
+    tric_report()->end(context->suite, NULL, tric_report()->data);
+    return tric_run_fixture(tric_data()->teardown, tric_data()->data) ? EX_OK : EX_TEMPFAIL;
 }
 
 
 
 /*
 internally used
-function to hold global reporting data
+execute a single test in a spawned process or in a process started with the environment variable TRIC_TEST_ID
+the ID of the test is followed by the file and the index of its record if the process was spawned
 */
-struct tric_reporting_data *tric_reporting(bool set, tric_logger_t start, tric_logger_t test, tric_logger_t end, void *data) {
-    static struct tric_reporting_data reporting = { .start = tric_log_start, .test = tric_log_test, .end = tric_log_end, .data = NULL };
-    if (set) {
-        reporting.start = start ? start : tric_log_nothing;
-        reporting.test = test ? test : tric_log_nothing;
-        reporting.end = end ? end : tric_log_nothing;
-        reporting.data = data;
+int tric_run_spawned(const char *value) {
+    size_t id;
+    size_t index = 0;
+    int file = -1;
+    int fields = sscanf(value, "%zu:%d:%zu", &id, &file, &index);
+    if ((fields != 1 && fields != 3) || id == 0) {
+        return EX_USAGE;
     }
-    return &reporting;
+    /* processes started by the test must execute the test suite again */
+    unsetenv(TRIC_TEST_ID);
+    size_t number_of_records = index + 1;
+    struct tric_context context = { .suite = tric_data()->suite, .records = tric_map_records(number_of_records, file), .number_of_records = number_of_records, .records_file = file, .spawned = id };
+    if (context.records == NULL) {
+        return EX_OSERR;
+    }
+    context.record = &context.records[index];
+    tric_find_tests(&context);
+    context.mode = MODE_RESET;
+    if (tric_run_fixture(tric_data()->setup, tric_data()->data)) {
+        tric_suite_function(&context);
+    }
+    /* the test was not found or the setup function failed */
+    return EXIT_NOT_STARTED;
 }
 
 
 
 /*
 internally used
-retrieve global reporting data
+the main function of a test suite is renamed to tric_main for the self tests, for the runner of several test suites and for programs processing test results, which define TRIC_NO_MAIN (e.g. tric_merge.c)
 */
-struct tric_reporting_data *tric_report(void) {
-    return tric_reporting(false, NULL, NULL, NULL, NULL);
-}
-
-
+#if defined(TRIC_SELF_TEST) || defined(TRIC_MULTIPLE_SUITES) || defined(TRIC_NO_MAIN)
+int tric_main(int argc, char *argv[]) {
+#else
 
 /**
- * \brief Set the log functions to report the test results.
+ * \brief Main function of the test suite.
  *
- * Logging can take place in 3 situations: At the start of the test suite (before any test is executed), directly after the execution of each test and at the end of the test suite (after all tests have been executed). When a log function is called at the start or end of the test suite, the test argument passed to the log function is NULL.
+ * The main function is automatically added to the file containing the test suite.
  *
- * \param start Function of type tric_logger_t that is executed after the setup fixture of the test suite has run and after the tests have been scanned but before any test is executed. May be NULL.
- * \param test Function of type tric_logger_t that is executed each time after a test was executed. May be NULL.
- * \param end Function of type tric_logger_t that is executed  after all tests have been executed but before the teardown fixture of the test suite is run. May be NULL.
- * \param data Pointer to user data that is passed to the logging functions.
+ * The environment variable TRIC_JOBS sets the maximum number of tests executed in parallel. It can be set to a positive number or to "auto" to use the number of available processors. By default the tests are executed one after another.
+ *
+ * The environment variable TRIC_TEST_TIMEOUT sets the timeout of each test in seconds. A test that takes longer is terminated together with all processes in its process group and marked with TRIC_TIMEOUT. If the environment variable TRIC_BACKTRACE is set to 1, a test that timed out prints a backtrace to stderr before it is terminated and the backtrace of a crashed test is recorded in the test data.
+ *
+ * Core dumps of crashing tests are disabled unless the environment variable TRIC_CORE_DUMP is set to 1.
+ *
+ * If the environment variable TRIC_SPAWN is set to 1, each test is executed in a new process of the test suite started with posix_spawn() (see TRIC_EXECUTE_SPAWN). The environment variable TRIC_TEST_ID executes only the test with the given ID in the process of the test suite itself, e.g. to debug it. Then the exit status is 0 if the test passed.
+ *
+ * The environment variable TRIC_REPEAT sets how often each test must pass and TRIC_RETRIES sets how often a failing test is executed again (see struct tric_options).
+ *
+ * The environment variable TRIC_FILTER selects the tests whose description matches the given pattern (see fnmatch()), e.g. "parse*". The environment variable TRIC_TESTS selects the tests with the given IDs, e.g. "3,7-9,12-". The environment variable TRIC_TAGS selects the tests by their tags, e.g. "io,!slow" (see struct tric_options). Tests that are not selected are reported as skipped without creating a process for them.
+ *
+ * The environment variables TRIC_SHARD_COUNT and TRIC_SHARD_INDEX split the tests into shards, e.g. to execute them on several machines, and execute only the tests of one shard (starting at 0). The tests of the other shards are reported as not in shard (TRIC_NOT_IN_SHARD). If TRIC_SHARD_INDEX is not a number smaller than TRIC_SHARD_COUNT, no test is executed and main returns EX_USAGE.
+ *
+ * The environment variable TRIC_HISTORY sets a file in which the results and durations of the tests are recorded. The durations of a previous run are used to distribute the tests to the shards, so that all shards take about the same time. Shards only read the file, the results of the shards are recorded by tric_merge. Without durations the tests are distributed by their ID. If the tests are executed in parallel, the longest tests of the previous run are started first. If the environment variable TRIC_FAILED_FIRST is set to 1, the tests that failed in the previous run are started first. If TRIC_RERUN_FAILED is set to 1, only these tests and tests without a result in the history are executed, all other tests are reported as skipped.
+ *
+ * The environment variable TRIC_MAX_FAILURES stops the test suite after the given number of failed tests, e.g. 1 to stop at the first failure. No further tests are started, tests still running in parallel are terminated and all these tests are reported as not run (TRIC_NOT_RUN).
+ *
+ * The environment variable TRIC_TIME_BUDGET sets the time available to execute the test suite, e.g. "120s" or "2m". With the durations of the history, the tests that failed in the previous run, new tests, tests deferred in the previous run and the other tests are selected in this order as long as they fit into the time budget. All other tests and tests whose previous duration exceeds the remaining time are reported as deferred (TRIC_DEFERRED) and are preferred in the next run. Of the tests that take longer than the whole budget, one is executed in each run, so they are executed in turn.
+ *
+ * The environment variable TRIC_BATCH sets the maximum number of tests executed one after another in the same process. It can be set to a positive number or to "auto" to start further tests in the same process only for a short time. A new process is created after a test failed. TRIC_BATCH is ignored if the tests are executed in parallel.
+ *
+ * \return If all tests of the test suite as well as the setup and teardown functions were executed successfully, main returns 0 (or EX_OK). Otherwise main returns EX_OSERR if the shared memory for the test records can not be mapped, EX_UNAVAILABLE if the setup function fails, EX_TEMPFAIL if the teardown function fails or EX_USAGE if TRIC_SHARD_INDEX does not select a shard.
  */
-void tric_log(tric_logger_t start, tric_logger_t test, tric_logger_t end, void *data) {
-    tric_reporting(true, start, test, end, data);
+int main(int argc, char *argv[]) {
+#endif
+    tric_settings()->timeout = tric_timeout(getenv(TRIC_TEST_TIMEOUT));
+    tric_settings()->backtrace = getenv(TRIC_BACKTRACE) != NULL && strcmp(getenv(TRIC_BACKTRACE), "1") == 0;
+    tric_settings()->core_dump = getenv(TRIC_CORE_DUMP) != NULL && strcmp(getenv(TRIC_CORE_DUMP), "1") == 0;
+    tric_settings()->repeat = tric_count(getenv(TRIC_REPEAT));
+    tric_settings()->retries = tric_retries(getenv(TRIC_RETRIES));
+    tric_settings()->filter = getenv(TRIC_FILTER);
+    tric_settings()->tests = getenv(TRIC_TESTS);
+    tric_settings()->tags = getenv(TRIC_TAGS);
+    tric_settings()->shard_count = tric_count(getenv(TRIC_SHARD_COUNT));
+    tric_settings()->shard_index = tric_shard_index(getenv(TRIC_SHARD_INDEX));
+    /* a wrong index would execute the tests of another shard again, so it is rejected */
+    if (tric_settings()->shard_count > 1 && tric_settings()->shard_index >= tric_settings()->shard_count) {
+        return EX_USAGE;
+    }
+    if (tric_settings()->shard_count == 1) {
+        tric_settings()->shard_index = 0;
+    }
+    tric_settings()->history = getenv(TRIC_HISTORY);
+    tric_settings()->failed_first = getenv(TRIC_FAILED_FIRST) != NULL && strcmp(getenv(TRIC_FAILED_FIRST), "1") == 0;
+    tric_settings()->rerun_failed = getenv(TRIC_RERUN_FAILED) != NULL && strcmp(getenv(TRIC_RERUN_FAILED), "1") == 0;
+    tric_settings()->max_failures = tric_max_failures(getenv(TRIC_MAX_FAILURES));
+    tric_settings()->time_budget = tric_time_budget(getenv(TRIC_TIME_BUDGET));
+    if (getenv(TRIC_SPAWN) != NULL && strcmp(getenv(TRIC_SPAWN), "1") == 0) {
+        tric_settings()->execution = TRIC_EXECUTE_SPAWN;
+    }
+    if (getenv(TRIC_TEST_ID) != NULL) {
+        return tric_run_spawned(getenv(TRIC_TEST_ID));
+    }
+#ifdef __linux__
+    prctl(PR_SET_CHILD_SUBREAPER, 1);
+#endif
+    size_t jobs = tric_jobs(getenv(TRIC_JOBS));
+    struct tric_batch batch = tric_batch(jobs > 1 ? NULL : getenv(TRIC_BATCH));
+    size_t number_of_records = jobs > batch.size ? jobs : batch.size;
+    /* groups of tests sharing a before function are executed by a single process like a batch */
+    number_of_records = number_of_records > TRIC_BATCH_LIMIT ? number_of_records : TRIC_BATCH_LIMIT;
+    /* tests waiting to be started in the order of the history keep their records */
+    if (tric_settings()->history != NULL && (jobs > 1 || tric_settings()->failed_first)) {
+        number_of_records += TRIC_HELD_LIMIT;
+    }
+    int records_file = tric_create_records_file(number_of_records);
+    struct tric_context context = { .suite = tric_data()->suite, .records = tric_map_records(number_of_records, records_file), .number_of_records = number_of_records, .records_file = records_file, .batch = batch };
+    if (context.records == NULL) {
+        return EX_OSERR;
+    }
+    context.record = context.records;
+    tric_find_tests(&context);
+    tric_store_tests(context.suite);
+    tric_read_history(context.suite, tric_settings()->history);
+    tric_assign_shards(context.suite, tric_settings()->shard_count);
+    tric_defer_tests(context.suite, tric_settings()->time_budget, jobs);
+    struct tric_queue queue = { .jobs = jobs, .entries = NULL, .ranks = tric_create_schedule(context.suite, jobs) };
+    context.queue = tric_create_queue(&queue, context.suite->number_of_tests);
+    tric_settings()->jobs = jobs;
+    int result = tric_run_tests(&context);
+    free(queue.entries);
+    free(queue.ranks);
+    tric_write_history(context.suite, tric_settings()->history);
+    tric_free_tests(context.suite);
+    tric_unmap_records(context.records, context.number_of_records);
+    if (records_file >= 0) {
+        close(records_file);
+    }
+    return result;
 }
 
 
 
+#ifdef TRIC_MULTIPLE_SUITES
 /*
 internally used
-execute setup or teardown function of test suite
+function to hold the test suite currently executed by the runner
 */
-bool tric_run_fixture(tric_fixture_t fixture, void *data) {
-    if (fixture == NULL) {
-        return true;
+const struct tric_suite_entry *tric_current_suite(bool set, const struct tric_suite_entry *entry) {
+    static const struct tric_suite_entry *current = NULL;
+    if (set) {
+        current = entry;
     }
-    return fixture(data);
+    return current;
 }
 
 
 
 /*
 internally used
-scan suite for tests
+data of the test suite currently executed by the runner
 */
-void tric_scan_tests(struct tric_context *context) {
-    context->mode = MODE_SCAN;
-    context->test = NULL;
-    tric_suite_function(context);
-    context->mode = MODE_RESET;
+const struct tric_suite_data *tric_data(void) {
+    return tric_current_suite(false, NULL)->data;
 }
 
 
 
 /*
 internally used
-execute tests of suite
+execute the tests of the test suite currently executed by the runner
 */
-int tric_run_tests(struct tric_context *context) {
-    context->mode = MODE_RESET;
-    if (tric_run_fixture(tric_data()->setup, tric_data()->data) == false) {
-        return EX_UNAVAILABLE;
-    }
-    tric_report()->start(context->suite, NULL, tric_report()->data);
-    tric_suite_function(context);
-    tric_report()->end(context->suite, NULL, tric_report()->data);
-    return tric_run_fixture(tric_data()->teardown, tric_data()->data) ? EX_OK : EX_TEMPFAIL;
+void tric_suite_function(struct tric_context *tric_context) {
+    tric_current_suite(false, NULL)->function(tric_context);
 }
 
 
 
-#ifdef TRIC_SELF_TEST
-int tric_main(int argc, char *argv[]) {
-#else
+/*
+internally used
+report the results of all test suites after the last test suite if the default reporting is used
+*/
+void tric_log_suites(const struct tric_suite *total, size_t number_of_suites) {
+    if (tric_report()->end != tric_log_end) {
+        return;
+    }
+    printf("\n%zu test %s: ", number_of_suites, number_of_suites == 1 ? "suite" : "suites");
+    printf("%zu %s executed, %zu failed, %zu skipped", total->executed_tests, total->executed_tests == 1 ? "test" : "tests", total->failed_tests, total->skipped_tests);
+    if (total->not_in_shard_tests > 0) {
+        printf(", %zu not in shard", total->not_in_shard_tests);
+    }
+    if (total->not_run_tests > 0) {
+        printf(", %zu not run", total->not_run_tests);
+    }
+    if (total->deferred_tests > 0) {
+        printf(", %zu deferred", total->deferred_tests);
+    }
+    printf(", %zu total\n", total->number_of_tests);
+}
+
+
 
 /**
- * \brief Main function of the test suite.
+ * \brief Main function of the runner of several test suites.
  *
- * The main function is automatically added to the file containing the test suite.
+ * If TRIC_MULTIPLE_SUITES is defined, the main function is added to the file defining TRIC_RUNNER. It executes the test suites of all files linked into the executable one after another, each in the same way as the main function of a single test suite. The tests of a test suite are found by scanning the test suite. The settings and the reporting are restored before each test suite, so a setup fixture of a test suite only affects its own tests. With the default reporting the results of all test suites are summarized at the end, the other output formats of tric_output.h report each test suite on its own.
  *
- * \return If all tests of the test suite as well as the setup and teardown functions were executed successfully, main returns 0 (or EX_OK). Otherwise main returns EX_NOINPUT if the executable can not be opened for reading, EX_UNAVAILABLE if the setup function fails or EX_TEMPFAIL if the teardown function fails.
+ * The environment variable TRIC_SUITE executes only the test suite with the given number (test suites are numbered from 1 in the order they are linked). The environment variable TRIC_TEST_ID executes a single test of the test suite selected with TRIC_SUITE or of the first test suite.
+ *
+ * \return If all test suites were executed successfully, main returns 0 (or EX_OK). Otherwise main returns the value returned for the first test suite that failed, or EX_USAGE if TRIC_SUITE does not select a test suite.
  */
 int main(int argc, char *argv[]) {
-#endif
-    struct tric_context context = { .suite = tric_data()->suite };
-    if ((context.self = open(argv[0], O_RDONLY)) == -1) {
-        return EX_NOINPUT;
+    size_t number_of_suites = __stop_tric_suites - __start_tric_suites;
+    const char *value = getenv(TRIC_SUITE);
+    size_t selected = tric_suite_number(value);
+    if (value != NULL && (selected == 0 || selected > number_of_suites)) {
+        return EX_USAGE;
     }
-    tric_scan_tests(&context);
-    int result = tric_run_tests(&context);
-    close(context.self);
+    const struct tric_settings settings = *tric_settings();
+    const struct tric_reporting_data reporting = *tric_report();
+    struct tric_suite total = NEW_SUITE("test suites");
+    size_t executed_suites = 0;
+    int result = EX_OK;
+    size_t i;
+    for (i = 0; i < number_of_suites; i++) {
+        if (selected > 0 && i + 1 != selected) {
+            continue;
+        }
+        char number[24];
+        snprintf(number, sizeof(number), "%zu", i + 1);
+        /* spawned processes of the tests must execute the same test suite */
+        setenv(TRIC_SUITE, number, 1);
+        *tric_settings() = settings;
+        *tric_report() = reporting;
+        tric_current_suite(true, &__start_tric_suites[i]);
+        if (getenv(TRIC_TEST_ID) != NULL) {
+            return tric_main(argc, argv);
+        }
+        int suite_result = tric_main(argc, argv);
+        result = result == EX_OK ? suite_result : result;
+        const struct tric_suite *suite = tric_data()->suite;
+        total.number_of_tests += suite->number_of_tests;
+        total.executed_tests += suite->executed_tests;
+        total.failed_tests += suite->failed_tests;
+        total.skipped_tests += suite->skipped_tests;
+        total.not_in_shard_tests += suite->not_in_shard_tests;
+        total.not_run_tests += suite->not_run_tests;
+        total.deferred_tests += suite->deferred_tests;
+        executed_suites++;
+    }
+    if (value == NULL) {
+        unsetenv(TRIC_SUITE);
+    }
+    *tric_report() = reporting;
+    tric_log_suites(&total, executed_suites);
     return result;
 }
+#endif
+
+
+
+#endif
 
 
 
@@ -335,6 +335,23 @@ ASSERT( fabs( (double)(F1) - (double)(F2) ) < (double)(PRECISION) )
 
 
 
+#ifndef TRIC_DEFINITIONS
+/*
+ internally used
+functions used by the assertions, defined in the file of the runner if several test suites are linked into one runner or in the library
+*/
+bool tric_assert_flag(size_t bits, size_t flags);
+bool tric_assert_not_flag(size_t bits, size_t flags);
+bool tric_assert_string_equal(const char *s1, const char *s2);
+bool tric_assert_string_prefix(const char *string, const char *prefix);
+bool tric_assert_string_suffix(const char *string, const char *suffix);
+bool tric_assert_string_contains(const char *string, const char *substring);
+bool tric_assert_memory_equal(void *m1, void *m2, size_t size);
+#endif
+
+
+
+#ifdef TRIC_DEFINITIONS
 /*
  internally used
 test if certain flags are set in bits
@@ -436,3 +453,7 @@ bool tric_assert_memory_equal(void *m1, void *m2, size_t size) {
 
 
 
+#endif
+
+
+
@@ -0,0 +1,615 @@
+/*
+TRIC - Minimalistic unit testing framework for c
+Merge the results of the shards of test suites into one report
+Copyright 2024 Philip Colombo
+
+This file is part of TRIC.
+
+TRIC is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+TRIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with TRIC.  If not, see <https://www.gnu.org/licenses/>.
+
+*/
+
+
+
+/*
+The program reads the results of the shards of test suites in the JSON output format (TRIC_OUTPUT_FORMAT=json) from the files given as arguments or from stdin and reports the merged results of each test suite in the output format set by TRIC_OUTPUT_FORMAT.
+Each line of the input holds the results of one test suite. The files are read line by line and the tests are merged into a table by their ID, so the time to merge the results grows linearly with the size of the input and the memory only with the number of tests.
+*/
+
+#define TRIC_NO_MAIN
+#include "tric.h"
+#include "tric_output.h"
+
+
+
+/*
+the program executes no tests, the empty test suite only completes the functions of TRIC
+*/
+SUITE("tric_merge", NULL, NULL, NULL) {
+}
+
+
+
+/*
+test suite merged from the results of its shards
+*/
+struct tric_merge_suite {
+    struct tric_suite suite;
+    size_t capacity;
+    struct tric_merge_suite *next;
+};
+
+
+
+/*
+test suites in the order they appear first in the input
+*/
+struct tric_merge {
+    struct tric_merge_suite *suites;
+    struct tric_merge_suite *last;
+};
+
+
+
+/*
+skip white space of the input
+*/
+void tric_merge_space(char **json) {
+    while (**json == ' ' || **json == '\t' || **json == '\r' || **json == '\n') {
+        (*json)++;
+    }
+}
+
+
+
+/*
+skip white space and the expected character, return false if the input continues with another character
+*/
+bool tric_merge_expect(char **json, char character) {
+    tric_merge_space(json);
+    if (**json != character) {
+        return false;
+    }
+    (*json)++;
+    return true;
+}
+
+
+
+/*
+decode a string in place, the input is never shorter than the decoded string
+return the decoded string or NULL if the input is not a string
+*/
+char *tric_merge_string(char **json) {
+    if (tric_merge_expect(json, '"') == false) {
+        return NULL;
+    }
+    char *string = *json;
+    char *output = string;
+    while (**json != '"') {
+        if (**json == '\0') {
+            return NULL;
+        }
+        if (**json == '\\') {
+            (*json)++;
+            if (**json == '\0') {
+                return NULL;
+            }
+            *output++ = **json == 'n' ? '\n' : **json == 't' ? '\t' : **json == 'r' ? '\r' : **json;
+        } else {
+            *output++ = **json;
+        }
+        (*json)++;
+    }
+    (*json)++;
+    *output = '\0';
+    return string;
+}
+
+
+
+/*
+decode a list of strings in place and join them with commas like the tags of a test
+return the joined strings or NULL if the input is not a list of strings
+*/
+char *tric_merge_tags(char **json) {
+    if (tric_merge_expect(json, '[') == false) {
+        return NULL;
+    }
+    char *tags = *json;
+    size_t length = 0;
+    if (tric_merge_expect(json, ']')) {
+        *tags = '\0';
+        return tags;
+    }
+    do {
+        char *tag = tric_merge_string(json);
+        if (tag == NULL) {
+            return NULL;
+        }
+        if (length > 0) {
+            tags[length++] = ',';
+        }
+        size_t size = strlen(tag);
+        memmove(tags + length, tag, size);
+        length += size;
+    } while (tric_merge_expect(json, ','));
+    if (tric_merge_expect(json, ']') == false) {
+        return NULL;
+    }
+    tags[length] = '\0';
+    return tags;
+}
+
+
+
+/*
+read a number, return false if the input is not a number
+*/
+bool tric_merge_number(char **json, double *value) {
+    tric_merge_space(json);
+    char *end;
+    *value = strtod(*json, &end);
+    if (end == *json) {
+        return false;
+    }
+    *json = end;
+    return true;
+}
+
+
+
+/*
+read a positive integer, return false if the input is not a positive integer
+*/
+bool tric_merge_size(char **json, size_t *value) {
+    tric_merge_space(json);
+    if (**json < '0' || **json > '9') {
+        return false;
+    }
+    char *end;
+    *value = strtoull(*json, &end, 10);
+    *json = end;
+    return true;
+}
+
+
+
+/*
+read the name of a result, return false if the input is not a string
+*/
+bool tric_merge_result(char **json, enum tric_result *result) {
+    char *name = tric_merge_string(json);
+    if (name == NULL) {
+        return false;
+    }
+    *result = tric_result_value(name);
+    return true;
+}
+
+
+
+/*
+skip a value of an unknown property, return false if the input is not a value
+*/
+bool tric_merge_skip(char **json) {
+    tric_merge_space(json);
+    if (**json == '"') {
+        return tric_merge_string(json) != NULL;
+    }
+    if (**json == '[' || **json == '{') {
+        char end = **json == '[' ? ']' : '}';
+        (*json)++;
+        if (tric_merge_expect(json, end)) {
+            return true;
+        }
+        do {
+            if (end == '}' && (tric_merge_string(json) == NULL || tric_merge_expect(json, ':') == false)) {
+                return false;
+            }
+            if (tric_merge_skip(json) == false) {
+                return false;
+            }
+        } while (tric_merge_expect(json, ','));
+        return tric_merge_expect(json, end);
+    }
+    size_t length = strspn(*json, "+-.0123456789Eaeflnrstu");
+    *json += length;
+    return length > 0;
+}
+
+
+
+/*
+read the value of a property of a test, return false if the value is invalid
+*/
+bool tric_merge_test_property(char **json, const char *name, struct tric_test *test) {
+    if (strcmp(name, "id") == 0) {
+        return tric_merge_size(json, &test->id) && test->id > 0;
+    } else if (strcmp(name, "description") == 0) {
+        return (test->description = tric_merge_string(json)) != NULL;
+    } else if (strcmp(name, "before") == 0) {
+        return tric_merge_result(json, &test->before);
+    } else if (strcmp(name, "result") == 0) {
+        return tric_merge_result(json, &test->result);
+    } else if (strcmp(name, "after") == 0) {
+        return tric_merge_result(json, &test->after);
+    } else if (strcmp(name, "line") == 0) {
+        return tric_merge_size(json, &test->line);
+    } else if (strcmp(name, "signal") == 0) {
+        return tric_merge_size(json, &test->signal);
+    } else if (strcmp(name, "duration") == 0) {
+        return tric_merge_number(json, &test->duration);
+    } else if (strcmp(name, "user_time") == 0) {
+        return tric_merge_number(json, &test->user_time);
+    } else if (strcmp(name, "system_time") == 0) {
+        return tric_merge_number(json, &test->system_time);
+    } else if (strcmp(name, "max_rss") == 0) {
+        return tric_merge_size(json, &test->max_rss);
+    } else if (strcmp(name, "minor_faults") == 0) {
+        return tric_merge_size(json, &test->minor_faults);
+    } else if (strcmp(name, "major_faults") == 0) {
+        return tric_merge_size(json, &test->major_faults);
+    } else if (strcmp(name, "voluntary_switches") == 0) {
+        return tric_merge_size(json, &test->voluntary_switches);
+    } else if (strcmp(name, "involuntary_switches") == 0) {
+        return tric_merge_size(json, &test->involuntary_switches);
+    } else if (strcmp(name, "stragglers") == 0) {
+        return tric_merge_size(json, &test->stragglers);
+    } else if (strcmp(name, "runs") == 0) {
+        return tric_merge_size(json, &test->runs);
+    } else if (strcmp(name, "failed_runs") == 0) {
+        return tric_merge_size(json, &test->failed_runs);
+    } else if (strcmp(name, "memory_limit") == 0) {
+        return tric_merge_size(json, &test->options.memory_limit);
+    } else if (strcmp(name, "cpu_limit") == 0) {
+        return tric_merge_size(json, &test->options.cpu_limit);
+    } else if (strcmp(name, "file_limit") == 0) {
+        return tric_merge_size(json, &test->options.file_limit);
+    } else if (strcmp(name, "output_limit") == 0) {
+        return tric_merge_size(json, &test->options.output_limit);
+    } else if (strcmp(name, "tags") == 0) {
+        return (test->options.tags = tric_merge_tags(json)) != NULL;
+    }
+    return tric_merge_skip(json);
+}
+
+
+
+/*
+read a test, return false if the test is invalid
+*/
+bool tric_merge_read_test(char **json, struct tric_test *test) {
+    if (tric_merge_expect(json, '{') == false) {
+        return false;
+    }
+    if (tric_merge_expect(json, '}')) {
+        return false;
+    }
+    do {
+        char *name = tric_merge_string(json);
+        if (name == NULL || tric_merge_expect(json, ':') == false || tric_merge_test_property(json, name, test) == false) {
+            return false;
+        }
+    } while (tric_merge_expect(json, ','));
+    return tric_merge_expect(json, '}') && test->id > 0 && test->description != NULL;
+}
+
+
+
+/*
+copy a string of the input, the strings of the input only live until the next line is read
+*/
+const char *tric_merge_copy(const char *string) {
+    if (string == NULL) {
+        return NULL;
+    }
+    char *copy = strdup(string);
+    if (copy == NULL) {
+        exit(EX_OSERR);
+    }
+    return copy;
+}
+
+
+
+/*
+find the test suite with the description or add it after the test suites found so far
+*/
+struct tric_merge_suite *tric_merge_find_suite(struct tric_merge *merge, const char *description) {
+    struct tric_merge_suite *current;
+    for (current = merge->suites; current != NULL; current = current->next) {
+        if (strcmp(current->suite.description, description) == 0) {
+            return current;
+        }
+    }
+    current = malloc(sizeof(struct tric_merge_suite));
+    if (current == NULL) {
+        exit(EX_OSERR);
+    }
+    *current = (struct tric_merge_suite){ .suite = NEW_SUITE(tric_merge_copy(description)), .capacity = 0, .next = NULL };
+    if (merge->last == NULL) {
+        merge->suites = current;
+    } else {
+        merge->last->next = current;
+    }
+    merge->last = current;
+    return current;
+}
+
+
+
+/*
+get the entry of the test with the ID in the table of the test suite, the table grows with the highest ID found
+*/
+struct tric_test *tric_merge_table_test(struct tric_merge_suite *merged, size_t id) {
+    if (id > merged->capacity) {
+        size_t capacity = merged->capacity > 0 ? merged->capacity : 16;
+        while (capacity < id) {
+            capacity *= 2;
+        }
+        struct tric_test *table = realloc(merged->suite.table, capacity * sizeof(struct tric_test));
+        if (table == NULL) {
+            exit(EX_OSERR);
+        }
+        size_t i;
+        for (i = merged->capacity; i < capacity; i++) {
+            table[i] = (struct tric_test)NEW_TEST(NULL);
+            table[i].id = i + 1;
+        }
+        merged->suite.table = table;
+        merged->capacity = capacity;
+    }
+    return &merged->suite.table[id - 1];
+}
+
+
+
+/*
+merge the result of a test into the test suite
+the first result found of a test is kept until the result of the shard that executed the test is found
+return false if several shards executed the test
+*/
+bool tric_merge_test(struct tric_merge_suite *merged, const struct tric_test *test) {
+    struct tric_test *entry = tric_merge_table_test(merged, test->id);
+    if (entry->description == NULL) {
+        *entry = *test;
+        entry->description = tric_merge_copy(test->description);
+        entry->options.tags = tric_merge_copy(test->options.tags);
+        return true;
+    }
+    if (test->result == TRIC_NOT_IN_SHARD) {
+        return true;
+    }
+    if (entry->result != TRIC_NOT_IN_SHARD) {
+        return false;
+    }
+    const char *description = entry->description;
+    const struct tric_options options = entry->options;
+    *entry = *test;
+    entry->description = description;
+    entry->options = options;
+    return true;
+}
+
+
+
+/*
+read the results of a test suite from a line of the input and merge them into the test suite with the same description
+return false if the line is invalid
+*/
+bool tric_merge_line(struct tric_merge *merge, char *line) {
+    char *json = line;
+    struct tric_merge_suite *merged = NULL;
+    if (tric_merge_expect(&json, '{') == false) {
+        return false;
+    }
+    do {
+        char *name = tric_merge_string(&json);
+        if (name == NULL || tric_merge_expect(&json, ':') == false) {
+            return false;
+        }
+        size_t value = 0;
+        if (strcmp(name, "description") == 0) {
+            char *description = tric_merge_string(&json);
+            if (description == NULL) {
+                return false;
+            }
+            merged = tric_merge_find_suite(merge, description);
+        } else if (merged == NULL) {
+            /* the description of the test suite precedes its results */
+            return false;
+        } else if (strcmp(name, "number_of_tests") == 0) {
+            /* all shards of a test suite find the same tests */
+            if (tric_merge_size(&json, &value) == false || (merged->suite.number_of_tests != 0 && merged->suite.number_of_tests != value)) {
+                return false;
+            }
+            merged->suite.number_of_tests = value;
+        } else if (strcmp(name, "executed_tests") == 0 || strcmp(name, "failed_tests") == 0 || strcmp(name, "skipped_tests") == 0) {
+            if (tric_merge_size(&json, &value) == false) {
+                return false;
+            }
+            /* every test is executed by exactly one shard, the other shards report it as not in shard */
+            size_t *counter = name[0] == 'e' ? &merged->suite.executed_tests : name[0] == 'f' ? &merged->suite.failed_tests : &merged->suite.skipped_tests;
+            *counter += value;
+        } else if (strcmp(name, "duration") == 0 || strcmp(name, "cpu_time") == 0) {
+            double seconds;
+            if (tric_merge_number(&json, &seconds) == false) {
+                return false;
+            }
+            /* the shards are executed at the same time, so the merged test suite takes as long as the longest shard */
+            if (name[0] == 'c') {
+                merged->suite.cpu_time += seconds;
+            } else if (seconds > merged->suite.duration) {
+                merged->suite.duration = seconds;
+            }
+        } else if (strcmp(name, "tests") == 0) {
+            if (tric_merge_expect(&json, '[') == false) {
+                return false;
+            }
+            if (tric_merge_expect(&json, ']')) {
+                continue;
+            }
+            do {
+                struct tric_test test = NEW_TEST(NULL);
+                if (tric_merge_read_test(&json, &test) == false || test.id > merged->suite.number_of_tests || tric_merge_test(merged, &test) == false) {
+                    return false;
+                }
+            } while (tric_merge_expect(&json, ','));
+            if (tric_merge_expect(&json, ']') == false) {
+                return false;
+            }
+        } else if (tric_merge_skip(&json) == false) {
+            return false;
+        }
+    } while (tric_merge_expect(&json, ','));
+    return tric_merge_expect(&json, '}') && merged != NULL;
+}
+
+
+
+/*
+read the results of the shards from a file line by line
+*/
+int tric_merge_file(struct tric_merge *merge, FILE *file, const char *path) {
+    char *line = NULL;
+    size_t size = 0;
+    size_t number = 0;
+    int result = EX_OK;
+    while (getline(&line, &size, file) != -1) {
+        number++;
+        char *json = line;
+        tric_merge_space(&json);
+        if (*json == '\0') {
+            continue;
+        }
+        if (tric_merge_line(merge, json) == false) {
+            fprintf(stderr, "tric_merge: %s:%zu: invalid test results or test executed by several shards\n", path, number);
+            result = EX_DATAERR;
+            break;
+        }
+    }
+    free(line);
+    return result;
+}
+
+
+
+/*
+link the tests of a merged test suite in the order of their IDs
+tests not reported by any shard keep an empty description, tests not executed by any shard stay not in shard
+*/
+void tric_merge_finish(struct tric_merge_suite *merged) {
+    struct tric_suite *suite = &merged->suite;
+    if (suite->number_of_tests > 0) {
+        tric_merge_table_test(merged, suite->number_of_tests);
+    }
+    suite->tests = suite->number_of_tests > 0 ? suite->table : NULL;
+    size_t i;
+    for (i = 0; i < suite->number_of_tests; i++) {
+        struct tric_test *test = &suite->table[i];
+        if (test->description == NULL) {
+            test->description = tric_merge_copy("");
+        }
+        if (test->result == TRIC_NOT_IN_SHARD) {
+            suite->not_in_shard_tests++;
+        } else if (test->result == TRIC_NOT_RUN) {
+            suite->not_run_tests++;
+        } else if (test->result == TRIC_DEFERRED) {
+            suite->deferred_tests++;
+        }
+        test->next = i + 1 < suite->number_of_tests ? &suite->table[i + 1] : NULL;
+    }
+}
+
+
+
+/*
+report the merged test suites with the reporting set by TRIC_OUTPUT_FORMAT
+*/
+void tric_merge_report(struct tric_merge *merge) {
+    const struct tric_reporting_data *reporting = tric_report();
+    struct tric_merge_suite *merged;
+    for (merged = merge->suites; merged != NULL; merged = merged->next) {
+        tric_merge_finish(merged);
+        struct tric_suite *suite = &merged->suite;
+        reporting->start(suite, NULL, reporting->data);
+        struct tric_test *test;
+        for (test = suite->tests; test != NULL; test = test->next) {
+            reporting->test(suite, test, reporting->data);
+        }
+        reporting->end(suite, NULL, reporting->data);
+    }
+}
+
+
+
+/*
+record the merged results in the history file set by TRIC_HISTORY, since the shards only read it
+tests not executed by any of the shards keep their previous results
+*/
+void tric_merge_history(struct tric_merge *merge, const char *path) {
+    struct tric_merge_suite *merged;
+    for (merged = merge->suites; merged != NULL; merged = merged->next) {
+        tric_read_history(&merged->suite, path);
+        tric_write_history(&merged->suite, path);
+    }
+}
+
+
+
+/*
+release the merged test suites
+*/
+void tric_merge_free(struct tric_merge *merge) {
+    while (merge->suites != NULL) {
+        struct tric_merge_suite *merged = merge->suites;
+        merge->suites = merged->next;
+        size_t i;
+        for (i = 0; i < merged->capacity; i++) {
+            free((char *)merged->suite.table[i].description);
+            free((char *)merged->suite.table[i].options.tags);
+        }
+        free(merged->suite.table);
+        free((char *)merged->suite.description);
+        free(merged);
+    }
+}
+
+
+
+/*
+merge the results of the files given as arguments, "-" or no argument reads stdin
+returns EX_NOINPUT if a file can not be read and EX_DATAERR if a file contains invalid results
+*/
+int main(int argc, char *argv[]) {
+    tric_output_environment();
+    struct tric_merge merge = { .suites = NULL, .last = NULL };
+    int result = EX_OK;
+    if (argc < 2) {
+        result = tric_merge_file(&merge, stdin, "-");
+    }
+    int i;
+    for (i = 1; i < argc && result == EX_OK; i++) {
+        FILE *file = strcmp(argv[i], "-") == 0 ? stdin : fopen(argv[i], "r");
+        if (file == NULL) {
+            fprintf(stderr, "tric_merge: %s: %s\n", argv[i], strerror(errno));
+            result = EX_NOINPUT;
+            break;
+        }
+        result = tric_merge_file(&merge, file, argv[i]);
+        if (file != stdin) {
+            fclose(file);
+        }
+    }
+    if (result == EX_OK) {
+        tric_merge_report(&merge);
+        tric_merge_history(&merge, getenv(TRIC_HISTORY));
+    }
+    tric_merge_free(&merge);
+    return result;
+}
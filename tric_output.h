@@ -62,12 +62,27 @@ SUITE("with TAP output", setup, NULL, NULL) {
 
 
 
+#ifndef TRIC_DEFINITIONS
+/*
+ internally used
+functions to set the output format, defined in the file of the runner if several test suites are linked into one runner or in the library
+*/
+void tric_output_tap(void);
+void tric_output_csv(bool header, bool unix_newline);
+void tric_output_csv_summary(bool header, bool unix_newline);
+void tric_output_json(void);
+void tric_output_environment(void);
+#endif
+
+
+
+#ifdef TRIC_DEFINITIONS
 /*
  internally used
 print string representation of execution results
 */
 void tric_print_result(enum tric_result result) {
-    const char *result_strings[] = { "undefined", "ok", "failure", "skipped", "crashed" };
+    const char *result_strings[] = { "undefined", "ok", "failure", "skipped", "crashed", "timeout", "exceeded", "not_in_shard", "not_run", "deferred" };
     printf("%s", result_strings[result + 1]);
 }
 
@@ -104,15 +119,27 @@ void tric_tap_header(struct tric_suite *suite, struct tric_test *test, void *dat
 
 
 
+/*
+ internally used
+check if test is reported as skipped in TAP
+*/
+bool tric_tap_skipped(struct tric_test *test) {
+    return (test->before == TRIC_UNDEFINED && test->result == TRIC_SKIPPED)
+    || (test->before == TRIC_SKIPPED && test->result == TRIC_SKIPPED)
+    || test->result == TRIC_NOT_IN_SHARD
+    || test->result == TRIC_NOT_RUN
+    || test->result == TRIC_DEFERRED;
+}
+
+
+
 /*
  internally used
 print TAP test status
 */
 void tric_tap_status(struct tric_test *test) {
     char *status = "not ok";
-    if (test->result == TRIC_OK
-    || (test->before == TRIC_UNDEFINED && test->result == TRIC_SKIPPED)
-    || (test->before == TRIC_SKIPPED && test->result == TRIC_SKIPPED)) {
+    if (test->result == TRIC_OK || tric_tap_skipped(test)) {
         status = "ok";
     }
     printf("%s", status);
@@ -146,8 +173,13 @@ print TAP directive
 */
 void tric_tap_directive(struct tric_test *test) {
     char *directive = "";
-    if ((test->before == TRIC_UNDEFINED && test->result == TRIC_SKIPPED)
-    || (test->before == TRIC_SKIPPED && test->result == TRIC_SKIPPED)) {
+    if (test->result == TRIC_NOT_IN_SHARD) {
+        directive = " # SKIP not in shard";
+    } else if (test->result == TRIC_NOT_RUN) {
+        directive = " # SKIP not run";
+    } else if (test->result == TRIC_DEFERRED) {
+        directive = " # SKIP deferred";
+    } else if (tric_tap_skipped(test)) {
         directive = " # SKIP";
     }
     printf("%s\n", directive);
@@ -155,6 +187,36 @@ void tric_tap_directive(struct tric_test *test) {
 
 
 
+/*
+ internally used
+print resource usage of executed test as TAP YAML diagnostic
+*/
+void tric_tap_usage(struct tric_test *test) {
+    if (tric_tap_skipped(test) || test->result == TRIC_UNDEFINED) {
+        return;
+    }
+    printf("  ---\n");
+    printf("  duration: %f\n", test->duration);
+    printf("  user_time: %f\n", test->user_time);
+    printf("  system_time: %f\n", test->system_time);
+    printf("  max_rss: %zu\n", test->max_rss);
+    printf("  minor_faults: %zu\n", test->minor_faults);
+    printf("  major_faults: %zu\n", test->major_faults);
+    printf("  voluntary_switches: %zu\n", test->voluntary_switches);
+    printf("  involuntary_switches: %zu\n", test->involuntary_switches);
+    printf("  stragglers: %zu\n", test->stragglers);
+    printf("  runs: %zu\n", test->runs);
+    printf("  failed_runs: %zu\n", test->failed_runs);
+    printf("  memory_limit: %zu\n", test->options.memory_limit);
+    printf("  cpu_limit: %zu\n", test->options.cpu_limit);
+    printf("  file_limit: %zu\n", test->options.file_limit);
+    printf("  output_limit: %zu\n", test->options.output_limit);
+    printf("  tags: \"%s\"\n", test->options.tags ? test->options.tags : "");
+    printf("  ...\n");
+}
+
+
+
 /*
  internally used
 print TAP test point
@@ -164,6 +226,7 @@ void tric_tap_test_point(struct tric_suite *suite, struct tric_test *test, void
     tric_tap_number(test->id);
     tric_tap_description(test->description);
     tric_tap_directive(test);
+    tric_tap_usage(test);
 }
 
 
@@ -173,6 +236,8 @@ void tric_tap_test_point(struct tric_suite *suite, struct tric_test *test, void
  *
  * Output test results in the <a href="https://testanything.org/tap-version-14-specification.html">TAP (Test Anything Protocol)</a> format according to version 14 of the TAP specification.
  *
+ * The execution time and resource usage of each executed test are reported in a YAML diagnostic block after the test point.
+ *
  * This function must be called before any test in the test suite is executed (i.e. in the test suite setup fixture).
  */
 void tric_output_tap(void) {
@@ -186,7 +251,7 @@ void tric_output_tap(void) {
 print csv header
 */
 void tric_csv_header(bool unix_newline) {
-    printf("ID,RESULT,LINE,SIGNAL,BEFORE,AFTER,DESCRIPTION%s", unix_newline ? "\n" : "\r\n");
+    printf("ID,RESULT,LINE,SIGNAL,BEFORE,AFTER,DESCRIPTION,DURATION,USER_TIME,SYSTEM_TIME,MAX_RSS,MINOR_FAULTS,MAJOR_FAULTS,VOLUNTARY_SWITCHES,INVOLUNTARY_SWITCHES,STRAGGLERS,RUNS,FAILED_RUNS,MEMORY_LIMIT,CPU_LIMIT,FILE_LIMIT,OUTPUT_LIMIT,TAGS%s", unix_newline ? "\n" : "\r\n");
 }
 
 
@@ -222,7 +287,12 @@ void tric_csv_record(struct tric_test *test, bool unix_newline) {
     tric_print_result(test->before);
     printf(",");
     tric_print_result(test->after);
-    printf(",\"%s\"%s", test->description, unix_newline ? "\n" : "\r\n");
+    printf(",\"%s\"", test->description);
+    printf(",%f,%f,%f", test->duration, test->user_time, test->system_time);
+    printf(",%zu,%zu,%zu,%zu,%zu", test->max_rss, test->minor_faults, test->major_faults, test->voluntary_switches, test->involuntary_switches);
+    printf(",%zu,%zu,%zu", test->stragglers, test->runs, test->failed_runs);
+    printf(",%zu,%zu,%zu,%zu", test->options.memory_limit, test->options.cpu_limit, test->options.file_limit, test->options.output_limit);
+    printf(",\"%s\"%s", test->options.tags ? test->options.tags : "", unix_newline ? "\n" : "\r\n");
 }
 
 
@@ -274,7 +344,7 @@ void tric_output_csv(bool header, bool unix_newline) {
 print csv summary header
 */
 void tric_csv_summary_header(bool unix_newline) {
-    printf("DESCRIPTION,TESTS,EXECUTED,FAILED,SKIPPED%s", unix_newline ? "\n" : "\r\n");
+    printf("DESCRIPTION,TESTS,EXECUTED,FAILED,SKIPPED,NOT_IN_SHARD,NOT_RUN,DEFERRED,DURATION,CPU_TIME%s", unix_newline ? "\n" : "\r\n");
 }
 
 
@@ -304,7 +374,7 @@ void tric_csv_summary_header_unix(struct tric_suite *suite, struct tric_test *te
 print csv summary record
 */
 void tric_csv_summary_record(struct tric_suite *suite, bool unix_newline) {
-    printf("\"%s\",%zu,%zu,%zu,%zu%s", suite->description, suite->number_of_tests, suite->executed_tests, suite->failed_tests, suite->skipped_tests, unix_newline ? "\n" : "\r\n");
+    printf("\"%s\",%zu,%zu,%zu,%zu,%zu,%zu,%zu,%f,%f%s", suite->description, suite->number_of_tests, suite->executed_tests, suite->failed_tests, suite->skipped_tests, suite->not_in_shard_tests, suite->not_run_tests, suite->deferred_tests, suite->duration, suite->cpu_time, unix_newline ? "\n" : "\r\n");
 }
 
 
@@ -351,6 +421,33 @@ void tric_output_csv_summary(bool header, bool unix_newline) {
 
 
 
+/*
+ internally used
+print comma separated list of tags as json list
+*/
+void tric_json_tags(const char *tags) {
+    printf("[");
+    const char *separator = " ";
+    while (tags != NULL && *tags != '\0') {
+        while (*tags == ' ') {
+            tags++;
+        }
+        int length = (int)strcspn(tags, ",");
+        const char *next = tags + length;
+        while (length > 0 && tags[length - 1] == ' ') {
+            length--;
+        }
+        if (length > 0) {
+            printf("%s\"%.*s\"", separator, length, tags);
+            separator = ", ";
+        }
+        tags = *next == ',' ? next + 1 : next;
+    }
+    printf(" ]");
+}
+
+
+
 /*
  internally used
 print test as json
@@ -362,7 +459,15 @@ void tric_json_test(struct tric_test *test) {
     tric_print_result(test->result);
     printf("\", \"after\": \"");
     tric_print_result(test->after);
-    printf("\", \"line\": %zu, \"signal\": %zu }", test->line, test->signal);
+    printf("\", \"line\": %zu, \"signal\": %zu", test->line, test->signal);
+    printf(", \"duration\": %f, \"user_time\": %f, \"system_time\": %f", test->duration, test->user_time, test->system_time);
+    printf(", \"max_rss\": %zu, \"minor_faults\": %zu, \"major_faults\": %zu", test->max_rss, test->minor_faults, test->major_faults);
+    printf(", \"voluntary_switches\": %zu, \"involuntary_switches\": %zu", test->voluntary_switches, test->involuntary_switches);
+    printf(", \"stragglers\": %zu, \"runs\": %zu, \"failed_runs\": %zu", test->stragglers, test->runs, test->failed_runs);
+    printf(", \"memory_limit\": %zu, \"cpu_limit\": %zu", test->options.memory_limit, test->options.cpu_limit);
+    printf(", \"file_limit\": %zu, \"output_limit\": %zu, \"tags\": ", test->options.file_limit, test->options.output_limit);
+    tric_json_tags(test->options.tags);
+    printf(" }");
 }
 
 
@@ -393,7 +498,7 @@ void tric_json_tests(struct tric_suite *suite) {
 print suite as json
 */
 void tric_json_suite(struct tric_suite *suite, struct tric_test *test, void *data) {
-    printf("{ \"description\": \"%s\", \"number_of_tests\": %zu, \"executed_tests\": %zu, \"failed_tests\": %zu, \"skipped_tests\": %zu, \"tests\": ", suite->description, suite->number_of_tests, suite->executed_tests, suite->failed_tests, suite->skipped_tests);
+    printf("{ \"description\": \"%s\", \"number_of_tests\": %zu, \"executed_tests\": %zu, \"failed_tests\": %zu, \"skipped_tests\": %zu, \"not_in_shard_tests\": %zu, \"not_run_tests\": %zu, \"deferred_tests\": %zu, \"duration\": %f, \"cpu_time\": %f, \"tests\": ", suite->description, suite->number_of_tests, suite->executed_tests, suite->failed_tests, suite->skipped_tests, suite->not_in_shard_tests, suite->not_run_tests, suite->deferred_tests, suite->duration, suite->cpu_time);
     tric_json_tests(suite);
     printf("}\n");
 }
@@ -538,3 +643,7 @@ void tric_output_environment(void) {
 
 
 
+#endif
+
+
+